@@ -0,0 +1,216 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_ACCUMULATOR_VIEW_HPP
+#define CRYPTO3_CLI_ACCUMULATOR_VIEW_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <nil/crypto3/cli/arena.hpp>
+#include <nil/crypto3/cli/arithmetic/compact_points.hpp>
+#include <nil/crypto3/cli/io.hpp>
+#include <nil/crypto3/cli/point_records.hpp>
+#include <nil/crypto3/cli/scheduler.hpp>
+#include <nil/crypto3/cli/sections.hpp>
+#include <nil/crypto3/cli/validation_cache.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+
+            /**
+             * One power vector of a mapped challenge or response. Elements are decoded and validated on access a
+             * chunk at a time and the most recently used chunks are kept, so sequential scans decode every point
+             * once while the resident set stays bounded by the cache size rather than by the ceremony size. Cached
+             * chunks hold their points compacted, affine where the curve allows it, so the same cache size holds
+             * more of them; native sections are in that form already. Given validated, every chunk is copied out
+             * of the mapping before it is hashed and decoded, and skips the subgroup check if its digest is listed.
+             * Safe to share between threads.
+             */
+            template<typename MarshallingPolicy, typename GroupType>
+            class section_view {
+            public:
+                using value_type = typename GroupType::value_type;
+
+                // A cached chunk is a validation chunk, so it has a digest of its own.
+                constexpr static const std::size_t chunk_elements = validation_chunk_records;
+
+                section_view(std::shared_ptr<const mapped_file> file,
+                             const accumulator_layout &layout,
+                             section where,
+                             task_cost cost,
+                             std::size_t cache_bytes,
+                             validation_cache *validated = nullptr) :
+                    file(std::move(file)),
+                    format(layout.format), where(where), extent(layout[where]), cost(cost), validated(validated) {
+                    if (extent.offset + extent.length() > this->file->size()) {
+                        throw std::invalid_argument("invalid format");
+                    }
+                    std::size_t chunk_bytes = chunk_elements * sizeof(storage_type);
+                    // Every thread scanning the section needs a chunk of its own to avoid thrashing.
+                    capacity =
+                        std::max<std::size_t>(cache_bytes / chunk_bytes, 2 * std::thread::hardware_concurrency());
+                }
+
+                section_view(const section_view &) = delete;
+                section_view &operator=(const section_view &) = delete;
+
+                std::size_t size() const {
+                    return extent.count;
+                }
+
+                value_type operator[](std::size_t i) const {
+                    BOOST_ASSERT(i < extent.count);
+                    return compact_type::expand((*chunk(i / chunk_elements))[i % chunk_elements]);
+                }
+
+                /// Decodes [first, first + count) in parallel, bypassing the cache; for bulk copies out of the view.
+                std::vector<value_type> decode(scheduler &s, std::size_t first, std::size_t count) const {
+                    if (first + count > extent.count) {
+                        throw std::out_of_range("requested powers lie beyond the end of the section");
+                    }
+                    file->advise_sequential(extent.offset + first * extent.element_size, count * extent.element_size);
+                    std::vector<value_type> points(count);
+                    for_each_validation_chunk(s, extent.count, first, count,
+                                              [&](std::size_t part_first, std::size_t part_count, bool whole) {
+                                                  load_range(part_first, part_count, points.data() + part_first - first,
+                                                             nullptr, whole);
+                                              });
+                    return points;
+                }
+
+            private:
+                using records_type = point_records<MarshallingPolicy, GroupType>;
+                using compact_type = typename records_type::compact_type;
+                using storage_type = typename compact_type::storage_type;
+                using chunk_type = std::vector<storage_type>;
+                using chunk_future = std::shared_future<std::shared_ptr<const chunk_type>>;
+                using lru_list = std::list<std::pair<std::size_t, chunk_future>>;
+
+                /**
+                 * Loads records [first, first + count), which only make up a whole chunk if whole says so. A record
+                 * which doesn't load throws a bad_point naming it.
+                 */
+                void load_range(std::size_t first,
+                                std::size_t count,
+                                value_type *points,
+                                storage_type *compact,
+                                bool whole) const {
+                    const std::uint8_t *records = file->data() + extent.offset + first * extent.element_size;
+                    try {
+                        if (validated == nullptr || !whole) {
+                            records_type::decode(format, records, count, points, compact);
+                            records_type::check(point_checks::full, points, count);
+                            return;
+                        }
+                        // The mapping may change under us; only a copy is sure to be decoded as it was hashed.
+                        scratch_scope scratch;
+                        scratch_vector<std::uint8_t> copy(records, records + count * extent.element_size,
+                                                          scratch.resource());
+                        records_type::load(format, copy.data(), count, points, compact, validated);
+                    } catch (const std::invalid_argument &e) {
+                        records_type::find_bad_point(format, where, first, records, count, e);
+                    }
+                }
+
+                std::shared_ptr<const chunk_type> chunk(std::size_t index) const {
+                    std::promise<std::shared_ptr<const chunk_type>> promise;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        auto it = chunks.find(index);
+                        if (it != chunks.end()) {
+                            lru.splice(lru.begin(), lru, it->second);
+                            chunk_future future = it->second->second;
+                            lock.unlock();
+                            return future.get();
+                        }
+                        // Claim the chunk before decoding it so concurrent readers wait instead of duplicating work.
+                        lru.emplace_front(index, promise.get_future().share());
+                        chunks[index] = lru.begin();
+                        if (lru.size() > capacity) {
+                            chunks.erase(lru.back().first);
+                            lru.pop_back();
+                        }
+                    }
+
+                    try {
+                        std::size_t first = index * chunk_elements;
+                        scratch_scope scratch;
+                        scratch_vector<value_type> decoded(std::min(chunk_elements, extent.count - first),
+                                                           scratch.resource());
+                        auto compact = std::make_shared<chunk_type>(decoded.size());
+                        load_range(first, decoded.size(), decoded.data(), compact->data(), true);
+                        promise.set_value(compact);
+                        return compact;
+                    } catch (...) {
+                        promise.set_exception(std::current_exception());
+                        throw;
+                    }
+                }
+
+                std::shared_ptr<const mapped_file> file;
+                point_format format;
+                section where;
+                section_extent extent;
+                task_cost cost;
+                validation_cache *validated;
+                std::size_t capacity;
+
+                mutable std::mutex mutex;
+                mutable lru_list lru;
+                mutable std::unordered_map<std::size_t, typename lru_list::iterator> chunks;
+            };
+
+            /**
+             * Accumulator backed by a mapped challenge or response. Exposes the members of accumulator_type
+             * with the same element access, so the verifier and other algorithms templated on the accumulator
+             * run on it unchanged, while only cache_bytes of decoded points are resident at a time.
+             */
+            template<typename MarshallingPolicy, typename CurveType>
+            class accumulator_view {
+                using g1_type = typename CurveType::template g1_type<>;
+                using g2_type = typename CurveType::template g2_type<>;
+
+                std::shared_ptr<const mapped_file> file;
+
+            public:
+                accumulator_view(const std::string &path, const accumulator_layout &layout, std::size_t cache_bytes,
+                                 validation_cache *validated = nullptr) :
+                    file(std::make_shared<mapped_file>(path)),
+                    tau_powers_g1(file, layout, section::tau_g1, task_cost::g1, cache_bytes / 4, validated),
+                    tau_powers_g2(file, layout, section::tau_g2, task_cost::g2, cache_bytes / 4, validated),
+                    alpha_tau_powers_g1(file, layout, section::alpha_tau_g1, task_cost::g1, cache_bytes / 4, validated),
+                    beta_tau_powers_g1(file, layout, section::beta_tau_g1, task_cost::g1, cache_bytes / 4, validated),
+                    beta_g2(section_view<MarshallingPolicy, g2_type>(file, layout, section::beta_g2, task_cost::g2, 0,
+                                                                      validated)[0]) {
+                }
+
+                section_view<MarshallingPolicy, g1_type> tau_powers_g1;
+                section_view<MarshallingPolicy, g2_type> tau_powers_g2;
+                section_view<MarshallingPolicy, g1_type> alpha_tau_powers_g1;
+                section_view<MarshallingPolicy, g1_type> beta_tau_powers_g1;
+                typename g2_type::value_type beta_g2;
+            };
+        }    // namespace cli
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_ACCUMULATOR_VIEW_HPP
@@ -0,0 +1,144 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_ARENA_HPP
+#define CRYPTO3_CLI_ARENA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+
+            /// Vector of temporaries whose storage comes from a scratch_scope.
+            template<typename T>
+            using scratch_vector = std::pmr::vector<T>;
+
+            /**
+             * Per-thread bump allocator for the temporaries of a chunk: the converted points and scalars the
+             * kernels work on, the decoded points of a cached chunk. Nothing is freed individually; the
+             * outermost scratch_scope on the thread rewinds the whole arena when it closes. A chunk which
+             * outgrows the buffer borrows from the heap, and the buffer grows to cover it on the rewind, so once
+             * the first chunks have been through, a thread makes no heap allocations for temporaries at all.
+             */
+            class scratch_arena : public std::pmr::memory_resource {
+                friend class scratch_scope;
+
+            public:
+                scratch_arena(const scratch_arena &) = delete;
+                scratch_arena &operator=(const scratch_arena &) = delete;
+
+                ~scratch_arena() override {
+                    release_overflow();
+                    if (buffer != nullptr) {
+                        ::operator delete(buffer, std::align_val_t(block_alignment));
+                    }
+                }
+
+                /// The calling thread's arena.
+                static scratch_arena &local() {
+                    thread_local scratch_arena arena;
+                    return arena;
+                }
+
+            private:
+                struct block {
+                    void *p;
+                    std::size_t bytes;
+                    std::size_t alignment;
+                };
+
+                constexpr static const std::size_t block_alignment = 64;
+                constexpr static const std::size_t initial_capacity = std::size_t(1) << 20;
+
+                scratch_arena() = default;
+
+                void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+                    std::size_t offset = (used + alignment - 1) / alignment * alignment;
+                    if (alignment <= block_alignment && offset + bytes <= capacity) {
+                        used = offset + bytes;
+                        return static_cast<std::byte *>(buffer) + offset;
+                    }
+                    alignment = std::max(alignment, block_alignment);
+                    overflow.push_back({::operator new(bytes, std::align_val_t(alignment)), bytes, alignment});
+                    return overflow.back().p;
+                }
+
+                void do_deallocate(void *, std::size_t, std::size_t) override {
+                }
+
+                bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+                    return this == &other;
+                }
+
+                void rewind() {
+                    if (!overflow.empty()) {
+                        std::size_t needed = used;
+                        for (const block &b : overflow) {
+                            needed += b.bytes + b.alignment;
+                        }
+                        release_overflow();
+                        if (buffer != nullptr) {
+                            ::operator delete(buffer, std::align_val_t(block_alignment));
+                            buffer = nullptr;
+                        }
+                        capacity = std::max({needed, 2 * capacity, initial_capacity});
+                        buffer = ::operator new(capacity, std::align_val_t(block_alignment));
+                    }
+                    used = 0;
+                }
+
+                void release_overflow() {
+                    for (const block &b : overflow) {
+                        ::operator delete(b.p, std::align_val_t(b.alignment));
+                    }
+                    overflow.clear();
+                }
+
+                void *buffer = nullptr;
+                std::size_t capacity = 0;
+                std::size_t used = 0;
+                std::vector<block> overflow;
+                std::size_t depth = 0;
+            };
+
+            /**
+             * Lends the thread's scratch_arena for the lifetime of the scope. Scopes nest, as they do when a
+             * thread waiting on a task group runs another chunk meanwhile, and only the outermost one rewinds,
+             * so an inner chunk never reuses memory an outer one still holds. The resource belongs to the thread
+             * which opened the scope and mustn't be allocated from on any other.
+             */
+            class scratch_scope {
+            public:
+                scratch_scope() : arena(scratch_arena::local()) {
+                    ++arena.depth;
+                }
+
+                scratch_scope(const scratch_scope &) = delete;
+                scratch_scope &operator=(const scratch_scope &) = delete;
+
+                ~scratch_scope() {
+                    if (--arena.depth == 0) {
+                        arena.rewind();
+                    }
+                }
+
+                std::pmr::memory_resource *resource() const {
+                    return &arena;
+                }
+
+            private:
+                scratch_arena &arena;
+            };
+        }    // namespace cli
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_ARENA_HPP
@@ -0,0 +1,288 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_ARITHMETIC_BATCH_HPP
+#define CRYPTO3_CLI_ARITHMETIC_BATCH_HPP
+
+#include <cstddef>
+#include <cstring>
+
+#include <nil/crypto3/cli/arithmetic/endomorphism.hpp>
+#include <nil/crypto3/cli/arithmetic/kernels.hpp>
+#include <nil/crypto3/cli/arithmetic/projective.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+                namespace detail {
+
+                    template<typename CurveOps>
+                    typename CurveOps::raw_type raw_identity() {
+                        typename CurveOps::raw_type r {};
+                        CurveOps::store(CurveOps::one(), [&](std::size_t) -> typename CurveOps::element_type & {
+                            return r.y;
+                        });
+                        return r;
+                    }
+
+                    /// Adds the lanes together; every lane ends up holding the total.
+                    template<typename CurveOps>
+                    projective<CurveOps> horizontal_sum(projective<CurveOps> p) {
+                        using raw_type = typename CurveOps::raw_type;
+
+                        for (std::size_t half = CurveOps::lanes / 2; half > 0; half /= 2) {
+                            raw_type lanes[CurveOps::lanes];
+                            store(p, [&](std::size_t lane) -> raw_type & { return lanes[lane]; });
+                            p = add(p, load<CurveOps>([&](std::size_t lane) -> const raw_type & {
+                                        return lanes[lane ^ half];
+                                    }));
+                        }
+                        return p;
+                    }
+
+                    /// Clears valid[lane] for every lane where a is not zero.
+                    template<typename CurveOps>
+                    void require_zero(const typename CurveOps::value_type &a, bool *valid) {
+                        using element_type = typename CurveOps::element_type;
+
+                        element_type lanes[CurveOps::lanes];
+                        CurveOps::store(a, [&](std::size_t lane) -> element_type & { return lanes[lane]; });
+                        // Stored elements are fully reduced, so zero is the all-zero bit pattern.
+                        const element_type zero {};
+                        for (std::size_t lane = 0; lane < CurveOps::lanes; ++lane) {
+                            valid[lane] = valid[lane] && std::memcmp(&lanes[lane], &zero, sizeof(zero)) == 0;
+                        }
+                    }
+
+                    template<typename CurveOps>
+                    projective<CurveOps> scalar_mul(const projective<CurveOps> &p, const scalar256 *scalars,
+                                                    constant_time) {
+                        return arithmetic::scalar_mul(p, scalars);
+                    }
+
+                    /// Vector backends keep their constant-time multiplication, which is faster across lanes.
+                    template<typename CurveOps>
+                    projective<CurveOps> scalar_mul(const projective<CurveOps> &p, const scalar256 *scalars,
+                                                    variable_time) {
+                        if constexpr (CurveOps::lanes == 1) {
+                            return scalar_mul_vartime(p, scalars);
+                        } else {
+                            return arithmetic::scalar_mul(p, scalars);
+                        }
+                    }
+
+                    /// Clears valid[lane] for every lane off the curve: Y^2 Z = X^3 + b Z^3.
+                    template<typename CurveOps>
+                    void require_on_curve(const projective<CurveOps> &p, bool *valid) {
+                        using value_type = typename CurveOps::value_type;
+
+                        // 3 (Y^2 Z - X^3) - 3b Z^3
+                        value_type lhs = CurveOps::sub(CurveOps::mul(CurveOps::sqr(p.y), p.z),
+                                                       CurveOps::mul(CurveOps::sqr(p.x), p.x));
+                        lhs = CurveOps::add(CurveOps::add(lhs, lhs), lhs);
+                        value_type rhs = CurveOps::mul_by_b3(CurveOps::mul(CurveOps::sqr(p.z), p.z));
+                        require_zero<CurveOps>(CurveOps::sub(lhs, rhs), valid);
+                    }
+
+                    /// Index of the first point check clears the lane of, a group of lanes at a time; count if none.
+                    template<typename CurveOps, typename Check>
+                    std::size_t first_rejected(const typename CurveOps::raw_type *points, std::size_t count,
+                                               Check check) {
+                        using raw_type = typename CurveOps::raw_type;
+
+                        const raw_type identity_point = raw_identity<CurveOps>();
+                        for (std::size_t first = 0; first < count; first += CurveOps::lanes) {
+                            std::size_t n = count - first < CurveOps::lanes ? count - first : CurveOps::lanes;
+                            projective<CurveOps> p = load<CurveOps>([&](std::size_t lane) -> const raw_type & {
+                                return lane < n ? points[first + lane] : identity_point;
+                            });
+
+                            bool valid[CurveOps::lanes];
+                            for (std::size_t lane = 0; lane < CurveOps::lanes; ++lane) {
+                                valid[lane] = true;
+                            }
+                            check(p, valid);
+
+                            for (std::size_t lane = 0; lane < n; ++lane) {
+                                if (!valid[lane]) {
+                                    return first + lane;
+                                }
+                            }
+                        }
+                        return count;
+                    }
+                }    // namespace detail
+
+                /**
+                 * Processes the points lanes at a time, padding the last group with the identity. Each group is
+                 * gathered from the columns and scattered back after its multiplication.
+                 */
+                template<typename CurveOps, typename TimingPolicy>
+                void multiply(point_columns<typename CurveOps::raw_type> &points, const scalar256 *scalars) {
+                    using raw_type = typename CurveOps::raw_type;
+
+                    const std::size_t count = points.size();
+                    const raw_type identity_point = detail::raw_identity<CurveOps>();
+                    raw_type group[CurveOps::lanes];
+                    scalar256 lane_scalars[CurveOps::lanes];
+
+                    for (std::size_t first = 0; first < count; first += CurveOps::lanes) {
+                        std::size_t n = count - first < CurveOps::lanes ? count - first : CurveOps::lanes;
+                        for (std::size_t lane = 0; lane < CurveOps::lanes; ++lane) {
+                            lane_scalars[lane] = lane < n ? scalars[first + lane] : scalar256 {};
+                            group[lane] = lane < n ? points.get(first + lane) : identity_point;
+                        }
+                        projective<CurveOps> p =
+                            load<CurveOps>([&](std::size_t lane) -> const raw_type & { return group[lane]; });
+                        p = detail::scalar_mul(p, lane_scalars, TimingPolicy());
+                        store(p, [&](std::size_t lane) -> raw_type & { return group[lane]; });
+                        for (std::size_t lane = 0; lane < n; ++lane) {
+                            points.set(first + lane, group[lane]);
+                        }
+                    }
+                }
+
+                template<typename CurveOps, typename TimingPolicy>
+                typename CurveOps::raw_type multi_multiply(const typename CurveOps::raw_type *points,
+                                                           const scalar256 *scalars,
+                                                           std::size_t count) {
+                    using raw_type = typename CurveOps::raw_type;
+
+                    const raw_type identity_point = detail::raw_identity<CurveOps>();
+                    scalar256 lane_scalars[CurveOps::lanes];
+
+                    projective<CurveOps> sum = identity<CurveOps>();
+                    for (std::size_t first = 0; first < count; first += CurveOps::lanes) {
+                        std::size_t n = count - first < CurveOps::lanes ? count - first : CurveOps::lanes;
+                        for (std::size_t lane = 0; lane < CurveOps::lanes; ++lane) {
+                            lane_scalars[lane] = lane < n ? scalars[first + lane] : scalar256 {};
+                        }
+                        projective<CurveOps> p = load<CurveOps>([&](std::size_t lane) -> const raw_type & {
+                            return lane < n ? points[first + lane] : identity_point;
+                        });
+                        sum = add(sum, detail::scalar_mul(p, lane_scalars, TimingPolicy()));
+                    }
+
+                    raw_type lanes[CurveOps::lanes];
+                    store(detail::horizontal_sum(sum), [&](std::size_t lane) -> raw_type & { return lanes[lane]; });
+                    return lanes[0];
+                }
+
+                /**
+                 * Index of the first point which is not on the curve or not in the prime-order subgroup, count if
+                 * there is none. Y^2 Z = X^3 + b Z^3 places a point on the curve; there, the endomorphism acts
+                 * as [|u|^u_power] on the subgroup and on no other point (Scott 2021, "A note on group
+                 * membership tests for G1, G2 and GT on BLS pairing-friendly curves"), so one (G2) or two (G1)
+                 * multiplications by the 64-bit |u| replace the one by the 255-bit group order. The points are
+                 * public, so this runs in variable time.
+                 */
+                template<typename CurveOps>
+                std::size_t validate(const typename CurveOps::raw_type *points, std::size_t count) {
+                    using endomorphism_type = endomorphism<CurveOps>;
+
+                    const typename endomorphism_type::constants constants = endomorphism_type::load_constants();
+                    auto check = [&](const projective<CurveOps> &p, bool *valid) {
+                        detail::require_on_curve(p, valid);
+
+                        projective<CurveOps> mapped = endomorphism_type::apply(p, constants);
+                        projective<CurveOps> multiplied = p;
+                        for (std::size_t i = 0; i < endomorphism_type::u_power; ++i) {
+                            multiplied = detail::mul_by_u_abs(multiplied);
+                        }
+                        // Equal as projective points: X1 Z2 = X2 Z1 and Y1 Z2 = Y2 Z1.
+                        detail::require_zero<CurveOps>(
+                            CurveOps::sub(CurveOps::mul(mapped.x, multiplied.z), CurveOps::mul(multiplied.x, mapped.z)),
+                            valid);
+                        detail::require_zero<CurveOps>(
+                            CurveOps::sub(CurveOps::mul(mapped.y, multiplied.z), CurveOps::mul(multiplied.y, mapped.z)),
+                            valid);
+                    };
+                    return detail::first_rejected<CurveOps>(points, count, check);
+                }
+
+                /// Index of the first point which is not on the curve, count if there is none; the cheap half of
+                /// validate, for points already known to be in the subgroup.
+                template<typename CurveOps>
+                std::size_t on_curve(const typename CurveOps::raw_type *points, std::size_t count) {
+                    auto check = [](const projective<CurveOps> &p, bool *valid) { detail::require_on_curve(p, valid); };
+                    return detail::first_rejected<CurveOps>(points, count, check);
+                }
+
+                /**
+                 * r[i] = op(a[i], b[i]) for i < count, lanes at a time, padding the last group with zero. Each group
+                 * is loaded before its result is stored, so r may be a or b.
+                 */
+                template<typename FieldOps, typename Op>
+                void field_map(fp381 *r, const fp381 *a, const fp381 *b, std::size_t count, Op op) {
+                    using value_type = typename FieldOps::value_type;
+
+                    const fp381 zero {};
+                    fp381 group[FieldOps::lanes];
+                    for (std::size_t first = 0; first < count; first += FieldOps::lanes) {
+                        std::size_t n = count - first < FieldOps::lanes ? count - first : FieldOps::lanes;
+                        value_type x = FieldOps::load([&](std::size_t lane) -> const fp381 & {
+                            return lane < n ? a[first + lane] : zero;
+                        });
+                        value_type y = FieldOps::load([&](std::size_t lane) -> const fp381 & {
+                            return lane < n ? b[first + lane] : zero;
+                        });
+                        FieldOps::store(op(x, y), [&](std::size_t lane) -> fp381 & { return group[lane]; });
+                        for (std::size_t lane = 0; lane < n; ++lane) {
+                            r[first + lane] = group[lane];
+                        }
+                    }
+                }
+
+                template<typename FieldOps>
+                void field_add(fp381 *r, const fp381 *a, const fp381 *b, std::size_t count) {
+                    field_map<FieldOps>(r, a, b, count, &FieldOps::add);
+                }
+
+                template<typename FieldOps>
+                void field_sub(fp381 *r, const fp381 *a, const fp381 *b, std::size_t count) {
+                    field_map<FieldOps>(r, a, b, count, &FieldOps::sub);
+                }
+
+                template<typename FieldOps>
+                void field_mul(fp381 *r, const fp381 *a, const fp381 *b, std::size_t count) {
+                    field_map<FieldOps>(r, a, b, count, &FieldOps::mul);
+                }
+
+                template<typename FieldOps>
+                void field_sqr(fp381 *r, const fp381 *a, std::size_t count) {
+                    using value_type = typename FieldOps::value_type;
+                    field_map<FieldOps>(r, a, a, count, [](const value_type &x, const value_type &) {
+                        return FieldOps::sqr(x);
+                    });
+                }
+
+                template<typename FieldOps>
+                constexpr kernel_table make_kernel_table(const char *name) {
+                    return {name,
+                            &multiply<g1_ops<FieldOps>, constant_time>,
+                            &multiply<g2_ops<FieldOps>, constant_time>,
+                            &multi_multiply<g1_ops<FieldOps>, constant_time>,
+                            &multi_multiply<g2_ops<FieldOps>, constant_time>,
+                            &multiply<g1_ops<FieldOps>, variable_time>,
+                            &multiply<g2_ops<FieldOps>, variable_time>,
+                            &multi_multiply<g1_ops<FieldOps>, variable_time>,
+                            &multi_multiply<g2_ops<FieldOps>, variable_time>,
+                            &validate<g1_ops<FieldOps>>,
+                            &validate<g2_ops<FieldOps>>,
+                            &on_curve<g1_ops<FieldOps>>,
+                            &on_curve<g2_ops<FieldOps>>,
+                            &field_add<FieldOps>,
+                            &field_sub<FieldOps>,
+                            &field_mul<FieldOps>,
+                            &field_sqr<FieldOps>};
+                }
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_ARITHMETIC_BATCH_HPP
@@ -0,0 +1,96 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_ARITHMETIC_COMPACT_POINTS_HPP
+#define CRYPTO3_CLI_ARITHMETIC_COMPACT_POINTS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+#include <nil/crypto3/algebra/curves/bls12.hpp>
+
+#include <nil/crypto3/cli/arena.hpp>
+#include <nil/crypto3/cli/arithmetic/curve_kernels.hpp>
+#include <nil/crypto3/cli/arithmetic/pairing.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+
+                /**
+                 * How decoded points are held where many of them stay resident, such as the chunk cache of a
+                 * mapped section. compress converts a batch into storage_type and expand converts one back on
+                 * access. The primary template keeps the points as they are.
+                 */
+                template<typename GroupValueType>
+                struct compact_points {
+                    using storage_type = GroupValueType;
+
+                    static void compress(const GroupValueType *points, storage_type *compact, std::size_t count) {
+                        std::copy(points, points + count, compact);
+                    }
+
+                    static GroupValueType expand(const storage_type &p) {
+                        return p;
+                    }
+                };
+
+                namespace detail {
+                    /**
+                     * BLS12-381 points held affine in Montgomery form: two coordinates instead of the library's
+                     * three, 104 bytes in G1 and 200 in G2. A batch shares one inversion; expand puts back
+                     * Z = 1 without one.
+                     */
+                    template<typename GroupValueType, typename AffineType>
+                    struct bls12_381_affine_points {
+                        using storage_type = AffineType;
+                        using kernels_type = curve_kernels<algebra::curves::bls12<381>>;
+                        using raw_type = decltype(kernels_type::to_raw(std::declval<GroupValueType>()));
+
+                        static void compress(const GroupValueType *points, storage_type *compact, std::size_t count) {
+                            scratch_scope scratch;
+                            scratch_vector<raw_type> raw(count, scratch.resource());
+                            for (std::size_t i = 0; i < count; ++i) {
+                                raw[i] = kernels_type::to_raw(points[i]);
+                            }
+                            to_affine(raw.data(), compact, count);
+                        }
+
+                        static GroupValueType expand(const storage_type &p) {
+                            if (p.infinity) {
+                                return GroupValueType::zero();
+                            }
+                            return kernels_type::template from_raw<GroupValueType>(raw_type {p.x, p.y, one(p.x)});
+                        }
+
+                    private:
+                        static fp381 one(const fp381 &) {
+                            return fp381_portable::one();
+                        }
+
+                        static fp2_381 one(const fp2_381 &) {
+                            return {fp381_portable::one(), fp381_portable::zero()};
+                        }
+                    };
+                }    // namespace detail
+
+                template<>
+                struct compact_points<typename algebra::curves::bls12<381>::template g1_type<>::value_type>
+                    : detail::bls12_381_affine_points<
+                          typename algebra::curves::bls12<381>::template g1_type<>::value_type, g1_affine> { };
+
+                template<>
+                struct compact_points<typename algebra::curves::bls12<381>::template g2_type<>::value_type>
+                    : detail::bls12_381_affine_points<
+                          typename algebra::curves::bls12<381>::template g2_type<>::value_type, g2_affine> { };
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_ARITHMETIC_COMPACT_POINTS_HPP
@@ -0,0 +1,51 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_ARITHMETIC_COMPRESSED_HPP
+#define CRYPTO3_CLI_ARITHMETIC_COMPRESSED_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <nil/crypto3/cli/arithmetic/pairing.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+
+                /// Byte order of an encoded coordinate; the flags are in its most significant byte either way.
+                enum class byte_order {
+                    big_endian,
+                    little_endian,
+                };
+
+                constexpr std::size_t g1_compressed_size = 48;
+                constexpr std::size_t g2_compressed_size = 96;
+
+                /**
+                 * Compressed BLS12-381 points as Zcash and the IETF pairing-friendly curves draft encode them: x
+                 * alone, fully reduced, the three top bits of its most significant byte flagging compression, the
+                 * point at infinity and the lexicographically larger of the two y. A G2 x = c0 + c1 u is the
+                 * integer c1 2^384 + c0. Records have a fixed size, so count points are consecutive records.
+                 */
+                void encode_compressed(const g1_affine *points, std::size_t count, std::uint8_t *out,
+                                       byte_order order);
+                void encode_compressed(const g2_affine *points, std::size_t count, std::uint8_t *out,
+                                       byte_order order);
+
+                /// False if one of the records isn't the canonical encoding of a point on the curve. Subgroup
+                /// membership is left to validation.
+                bool decode_compressed(const std::uint8_t *in, std::size_t count, g1_affine *points,
+                                       byte_order order);
+                bool decode_compressed(const std::uint8_t *in, std::size_t count, g2_affine *points,
+                                       byte_order order);
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_ARITHMETIC_COMPRESSED_HPP
@@ -0,0 +1,359 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_ARITHMETIC_CURVE_KERNELS_HPP
+#define CRYPTO3_CLI_ARITHMETIC_CURVE_KERNELS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include <nil/crypto3/algebra/curves/bls12.hpp>
+
+#include <nil/crypto3/cli/arena.hpp>
+#include <nil/crypto3/cli/arithmetic/fp381.hpp>
+#include <nil/crypto3/cli/arithmetic/fr255.hpp>
+#include <nil/crypto3/cli/arithmetic/kernels.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+
+                /**
+                 * Batched scalar multiplication of curve points. The primary template multiplies one point at a
+                 * time with the curve's own arithmetic, whatever the timing policy; curves with kernels
+                 * specialize it. Verification, whose points and scalars are public, names variable_time.
+                 */
+                template<typename CurveType, typename TimingPolicy = constant_time>
+                struct curve_kernels {
+                    /// points[i] = scalars[i] * points[i]
+                    template<typename GroupValueType, typename ScalarValueType>
+                    static void multiply(GroupValueType *points, const ScalarValueType *scalars, std::size_t count) {
+                        for (std::size_t i = 0; i < count; ++i) {
+                            points[i] = scalars[i] * points[i];
+                        }
+                    }
+
+                    /// points[i] = factor * tau^(first + i) * points[i]
+                    template<typename GroupValueType, typename ScalarValueType>
+                    static void multiply_by_powers(GroupValueType *points,
+                                                   std::size_t count,
+                                                   const ScalarValueType &factor,
+                                                   const ScalarValueType &tau,
+                                                   std::size_t first) {
+                        scratch_scope scratch;
+                        scratch_vector<ScalarValueType> scalars(count, scratch.resource());
+                        ScalarValueType scalar = factor * tau.pow(first);
+                        for (std::size_t i = 0; i < count; ++i) {
+                            scalars[i] = scalar;
+                            scalar *= tau;
+                        }
+                        multiply(points, scalars.data(), count);
+                    }
+
+                    /// Sum of scalars[i] * points[i].
+                    template<typename GroupValueType, typename ScalarValueType>
+                    static GroupValueType multi_multiply(const GroupValueType *points,
+                                                         const ScalarValueType *scalars,
+                                                         std::size_t count) {
+                        GroupValueType sum = GroupValueType::zero();
+                        for (std::size_t i = 0; i < count; ++i) {
+                            sum = sum + scalars[i] * points[i];
+                        }
+                        return sum;
+                    }
+
+                    /// Index of the first point off the curve or outside the prime-order subgroup; count if none.
+                    template<typename GroupValueType>
+                    static std::size_t validate(const GroupValueType *points, std::size_t count) {
+                        using scalar_field_type = typename CurveType::scalar_field_type;
+                        for (std::size_t i = 0; i < count; ++i) {
+                            if (!points[i].is_well_formed() || !(points[i] * scalar_field_type::modulus).is_zero()) {
+                                return i;
+                            }
+                        }
+                        return count;
+                    }
+
+                    /// Index of the first point off the curve; count if none.
+                    template<typename GroupValueType>
+                    static std::size_t on_curve(const GroupValueType *points, std::size_t count) {
+                        for (std::size_t i = 0; i < count; ++i) {
+                            if (!points[i].is_well_formed()) {
+                                return i;
+                            }
+                        }
+                        return count;
+                    }
+                };
+
+                /**
+                 * BLS12-381 runs on the kernels of the fastest backend the CPU supports. Points cross over
+                 * through their integer coordinates, so nothing depends on how the library represents field
+                 * elements internally; Jacobian coordinates are rescaled to homogeneous ones and back without
+                 * an inversion.
+                 */
+                template<typename TimingPolicy>
+                struct curve_kernels<algebra::curves::bls12<381>, TimingPolicy> {
+                    using curve_type = algebra::curves::bls12<381>;
+                    using g1_value_type = typename curve_type::template g1_type<>::value_type;
+                    using g2_value_type = typename curve_type::template g2_type<>::value_type;
+                    using scalar_value_type = typename curve_type::scalar_field_type::value_type;
+
+                    static void multiply(g1_value_type *points, const scalar_value_type *scalars, std::size_t count) {
+                        multiply_with(select(kernels().g1_mul, kernels().g1_mul_vartime), points, scalars, count);
+                    }
+
+                    static void multiply(g2_value_type *points, const scalar_value_type *scalars, std::size_t count) {
+                        multiply_with(select(kernels().g2_mul, kernels().g2_mul_vartime), points, scalars, count);
+                    }
+
+                    /// The powers are computed in fr255 and handed to the kernels as integers, never passing through
+                    /// the library's general multiprecision field.
+                    static void multiply_by_powers(g1_value_type *points,
+                                                   std::size_t count,
+                                                   const scalar_value_type &factor,
+                                                   const scalar_value_type &tau,
+                                                   std::size_t first) {
+                        scratch_scope scratch;
+                        multiply_raw(select(kernels().g1_mul, kernels().g1_mul_vartime), points,
+                                     powers(count, factor, tau, first, scratch.resource()));
+                    }
+
+                    static void multiply_by_powers(g2_value_type *points,
+                                                   std::size_t count,
+                                                   const scalar_value_type &factor,
+                                                   const scalar_value_type &tau,
+                                                   std::size_t first) {
+                        scratch_scope scratch;
+                        multiply_raw(select(kernels().g2_mul, kernels().g2_mul_vartime), points,
+                                     powers(count, factor, tau, first, scratch.resource()));
+                    }
+
+                    static g1_value_type multi_multiply(const g1_value_type *points,
+                                                        const scalar_value_type *scalars,
+                                                        std::size_t count) {
+                        return multi_multiply_with(select(kernels().g1_multi_mul, kernels().g1_multi_mul_vartime),
+                                                   points, scalars, count);
+                    }
+
+                    static g2_value_type multi_multiply(const g2_value_type *points,
+                                                        const scalar_value_type *scalars,
+                                                        std::size_t count) {
+                        return multi_multiply_with(select(kernels().g2_multi_mul, kernels().g2_multi_mul_vartime),
+                                                   points, scalars, count);
+                    }
+
+                    static std::size_t validate(const g1_value_type *points, std::size_t count) {
+                        return validate_with(kernels().g1_validate, points, count);
+                    }
+
+                    static std::size_t validate(const g2_value_type *points, std::size_t count) {
+                        return validate_with(kernels().g2_validate, points, count);
+                    }
+
+                    static std::size_t on_curve(const g1_value_type *points, std::size_t count) {
+                        return validate_with(kernels().g1_on_curve, points, count);
+                    }
+
+                    static std::size_t on_curve(const g2_value_type *points, std::size_t count) {
+                        return validate_with(kernels().g2_on_curve, points, count);
+                    }
+
+                    /// Jacobian (X, Y, Z) is homogeneous (X Z, Y, Z^3).
+                    static g1_raw to_raw(const g1_value_type &p) {
+                        fp381 x = to_raw_element(p.X), y = to_raw_element(p.Y), z = to_raw_element(p.Z);
+                        return {base_ops::mul(x, z), y, base_ops::mul(base_ops::sqr(z), z)};
+                    }
+
+                    static g2_raw to_raw(const g2_value_type &p) {
+                        auto x = load_fp2(to_raw_element(p.X)), y = load_fp2(to_raw_element(p.Y)),
+                             z = load_fp2(to_raw_element(p.Z));
+                        return {store_fp2(fp2_ops_type::mul(x, z)), store_fp2(y),
+                                store_fp2(fp2_ops_type::mul(fp2_ops_type::sqr(z), z))};
+                    }
+
+                    /// Homogeneous (X, Y, Z) is Jacobian (X Z, Y Z^2, Z).
+                    template<typename GroupValueType>
+                    static GroupValueType from_raw(const g1_raw &p) {
+                        using field_value_type = typename GroupValueType::field_type::value_type;
+                        if (base_ops::is_zero(p.z)) {
+                            return GroupValueType::zero();
+                        }
+                        return GroupValueType(from_raw_base<field_value_type>(base_ops::mul(p.x, p.z)),
+                                              from_raw_base<field_value_type>(
+                                                  base_ops::mul(p.y, base_ops::sqr(p.z))),
+                                              from_raw_base<field_value_type>(p.z));
+                    }
+
+                    template<typename GroupValueType>
+                    static GroupValueType from_raw(const g2_raw &p) {
+                        if (base_ops::is_zero(p.z.c0) & base_ops::is_zero(p.z.c1)) {
+                            return GroupValueType::zero();
+                        }
+                        auto x = load_fp2(p.x), y = load_fp2(p.y), z = load_fp2(p.z);
+                        return GroupValueType(from_raw_fp2<GroupValueType>(fp2_ops_type::mul(x, z)),
+                                              from_raw_fp2<GroupValueType>(
+                                                  fp2_ops_type::mul(y, fp2_ops_type::sqr(z))),
+                                              from_raw_fp2<GroupValueType>(z));
+                    }
+
+                private:
+                    using base_ops = fp381_portable;
+                    using fp2_ops_type = fp2_ops<base_ops>;
+
+                    template<typename Kernel>
+                    static Kernel select(Kernel constant_time_kernel, Kernel variable_time_kernel) {
+                        return std::is_same<TimingPolicy, variable_time>::value ? variable_time_kernel :
+                                                                                  constant_time_kernel;
+                    }
+
+                    template<typename Kernel, typename GroupValueType>
+                    static void multiply_with(Kernel kernel,
+                                              GroupValueType *points,
+                                              const scalar_value_type *scalars,
+                                              std::size_t count) {
+                        scratch_scope scratch;
+                        scratch_vector<scalar256> raw_scalars(count, scratch.resource());
+                        for (std::size_t i = 0; i < count; ++i) {
+                            raw_scalars[i] = to_raw(scalars[i]);
+                        }
+                        multiply_raw(kernel, points, std::move(raw_scalars));
+                    }
+
+                    /// The points cross over in columns, the storage the kernels multiply in.
+                    template<typename Kernel, typename GroupValueType>
+                    static void multiply_raw(Kernel kernel, GroupValueType *points, scratch_vector<scalar256> scalars) {
+                        using raw_type = decltype(to_raw(points[0]));
+
+                        const std::size_t count = scalars.size();
+                        point_columns<raw_type> raw(count);
+                        for (std::size_t i = 0; i < count; ++i) {
+                            raw[i] = to_raw(points[i]);
+                        }
+                        kernel(raw, scalars.data());
+                        for (std::size_t i = 0; i < count; ++i) {
+                            points[i] = from_raw<GroupValueType>(raw.get(i));
+                        }
+                        // The scalars are the contributor's secrets.
+                        wipe(scalars);
+                    }
+
+                    /// factor * tau^(first + i) for i below count, as integers.
+                    static scratch_vector<scalar256> powers(std::size_t count,
+                                                            const scalar_value_type &factor,
+                                                            const scalar_value_type &tau,
+                                                            std::size_t first,
+                                                            std::pmr::memory_resource *resource) {
+                        using fr = fr255_portable;
+
+                        scratch_vector<scalar256> scalars(count, resource);
+                        const fr::value_type tau_montgomery = fr::to_montgomery(to_raw(tau));
+                        fr::value_type scalar =
+                            fr::mul(fr::to_montgomery(to_raw(factor)), fr::pow(tau_montgomery, first));
+                        for (std::size_t i = 0; i < count; ++i) {
+                            scalars[i] = fr::from_montgomery(scalar);
+                            scalar = fr::mul(scalar, tau_montgomery);
+                        }
+                        return scalars;
+                    }
+
+                    template<typename Kernel, typename GroupValueType>
+                    static GroupValueType multi_multiply_with(Kernel kernel,
+                                                              const GroupValueType *points,
+                                                              const scalar_value_type *scalars,
+                                                              std::size_t count) {
+                        using raw_type = decltype(to_raw(points[0]));
+
+                        scratch_scope scratch;
+                        scratch_vector<raw_type> raw(count, scratch.resource());
+                        scratch_vector<scalar256> raw_scalars(count, scratch.resource());
+                        for (std::size_t i = 0; i < count; ++i) {
+                            raw[i] = to_raw(points[i]);
+                            raw_scalars[i] = to_raw(scalars[i]);
+                        }
+                        GroupValueType sum = from_raw<GroupValueType>(kernel(raw.data(), raw_scalars.data(), count));
+                        wipe(raw_scalars);
+                        return sum;
+                    }
+
+                    template<typename Kernel, typename GroupValueType>
+                    static std::size_t validate_with(Kernel kernel, const GroupValueType *points, std::size_t count) {
+                        using raw_type = decltype(to_raw(points[0]));
+
+                        scratch_scope scratch;
+                        scratch_vector<raw_type> raw(count, scratch.resource());
+                        for (std::size_t i = 0; i < count; ++i) {
+                            raw[i] = to_raw(points[i]);
+                        }
+                        return kernel(raw.data(), count);
+                    }
+
+                    static void wipe(scratch_vector<scalar256> &scalars) {
+                        volatile std::uint64_t *limbs = scalars.empty() ? nullptr : scalars.front().limbs.data();
+                        for (std::size_t i = 0; i < 4 * scalars.size(); ++i) {
+                            limbs[i] = 0;
+                        }
+                    }
+
+                    template<typename FieldValueType>
+                    static fp381 to_raw_base(const FieldValueType &x) {
+                        typename FieldValueType::field_type::integral_type integral(x.data);
+                        std::array<std::uint64_t, 6> words {};
+                        export_bits(integral, words.begin(), 64, false);
+                        return to_montgomery(words);
+                    }
+
+                    template<typename FieldValueType>
+                    static FieldValueType from_raw_base(const fp381 &x) {
+                        std::array<std::uint64_t, 6> words = from_montgomery(x);
+                        typename FieldValueType::field_type::integral_type integral;
+                        import_bits(integral, words.begin(), words.end(), 64, false);
+                        return FieldValueType(integral);
+                    }
+
+                    static fp381 to_raw_element(const typename g1_value_type::field_type::value_type &x) {
+                        return to_raw_base(x);
+                    }
+
+                    static fp2_381 to_raw_element(const typename g2_value_type::field_type::value_type &x) {
+                        return {to_raw_base(x.data[0]), to_raw_base(x.data[1])};
+                    }
+
+                    static scalar256 to_raw(const scalar_value_type &k) {
+                        typename curve_type::scalar_field_type::integral_type integral(k.data);
+                        scalar256 r {};
+                        export_bits(integral, r.limbs.begin(), 64, false);
+                        return r;
+                    }
+
+                    template<typename GroupValueType>
+                    static typename GroupValueType::field_type::value_type
+                        from_raw_fp2(const typename fp2_ops_type::value_type &a) {
+                        using fp2_value_type = typename GroupValueType::field_type::value_type;
+                        using fp_value_type =
+                            typename std::decay<decltype(std::declval<fp2_value_type>().data[0])>::type;
+                        return fp2_value_type(from_raw_base<fp_value_type>(a.c0),
+                                              from_raw_base<fp_value_type>(a.c1));
+                    }
+
+                    static typename fp2_ops_type::value_type load_fp2(const fp2_381 &a) {
+                        return {a.c0, a.c1};
+                    }
+
+                    static fp2_381 store_fp2(const typename fp2_ops_type::value_type &a) {
+                        return {a.c0, a.c1};
+                    }
+                };
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_ARITHMETIC_CURVE_KERNELS_HPP
@@ -0,0 +1,341 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_ARITHMETIC_ENDOMORPHISM_HPP
+#define CRYPTO3_CLI_ARITHMETIC_ENDOMORPHISM_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <nil/crypto3/cli/arithmetic/fp381.hpp>
+#include <nil/crypto3/cli/arithmetic/projective.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+                namespace detail {
+                    /// |u| for the BLS12-381 parameter u = -0xd201000000010000; the group order is u^4 - u^2 + 1.
+                    constexpr std::uint64_t u_abs = 0xd201000000010000;
+
+                    constexpr std::array<std::uint64_t, 4> group_order = {
+                        0xffffffff00000001, 0x53bda402fffe5bfe, 0x3339d80809a1d805, 0x73eda753299d7d48};
+
+                    /**
+                     * k mod r in base |u|: k = d0 + d1 |u| + d2 |u|^2 + d3 |u|^3 with every digit below |u|, as
+                     * r < |u|^4. Two conditional subtractions and bit-serial divisions, so the time is the same for
+                     * every k. Templated on the backend like the rest of the kernel code, so each instruction set's
+                     * translation unit keeps its own copy.
+                     */
+                    template<typename CurveOps>
+                    std::array<std::uint64_t, 4> base_u_digits(const scalar256 &k) {
+                        std::array<std::uint64_t, 4> n = k.limbs;
+                        // 2^256 < 3r
+                        for (std::size_t i = 0; i < 2; ++i) {
+                            std::array<std::uint64_t, 4> reduced;
+                            std::uint64_t borrow = 0;
+                            for (std::size_t j = 0; j < 4; ++j) {
+                                unsigned __int128 d =
+                                    static_cast<unsigned __int128>(n[j]) - group_order[j] - borrow;
+                                reduced[j] = static_cast<std::uint64_t>(d);
+                                borrow = static_cast<std::uint64_t>(d >> 64) & 1;
+                            }
+                            std::uint64_t keep = 0 - borrow;
+                            for (std::size_t j = 0; j < 4; ++j) {
+                                n[j] = (n[j] & keep) | (reduced[j] & ~keep);
+                            }
+                        }
+
+                        std::array<std::uint64_t, 4> digits;
+                        for (std::size_t d = 0; d < 3; ++d) {
+                            std::array<std::uint64_t, 4> quotient = {};
+                            unsigned __int128 remainder = 0;
+                            for (std::size_t bit = 256; bit-- > 0;) {
+                                remainder = (remainder << 1) | ((n[bit / 64] >> (bit % 64)) & 1);
+                                // remainder < 2 |u| < 2^65, so the difference is negative iff bit 127 is set.
+                                unsigned __int128 difference = remainder - u_abs;
+                                unsigned __int128 fits = (difference >> 127) - 1;
+                                remainder = (remainder & ~fits) | (difference & fits);
+                                quotient[bit / 64] |= static_cast<std::uint64_t>(fits & 1) << (bit % 64);
+                            }
+                            digits[d] = static_cast<std::uint64_t>(remainder);
+                            n = quotient;
+                        }
+                        digits[3] = n[0];
+                        return digits;
+                    }
+
+                    /**
+                     * Width-w NAF of a sub-scalar below 2^Bits: every digit zero or odd in (-2^(w-1), 2^(w-1)),
+                     * at most one nonzero digit in any w consecutive positions, and one position more than the
+                     * sub-scalar has bits. Branches on the scalar; for public scalars only.
+                     */
+                    template<typename CurveOps, std::size_t Bits, std::size_t Width>
+                    std::array<std::int8_t, Bits + 1> wnaf(const std::array<std::uint64_t, 2> &k) {
+                        std::array<std::int8_t, Bits + 1> digits {};
+                        // A third limb takes the carry of adding back negative digits.
+                        std::uint64_t n[3] = {k[0], k[1], 0};
+                        for (std::size_t i = 0; i < digits.size() && (n[0] | n[1] | n[2]) != 0; ++i) {
+                            if (n[0] & 1) {
+                                std::int64_t digit = static_cast<std::int64_t>(n[0] & ((1u << Width) - 1));
+                                if (digit >= (1 << (Width - 1))) {
+                                    digit -= 1 << Width;
+                                }
+                                digits[i] = static_cast<std::int8_t>(digit);
+                                if (digit > 0) {
+                                    // The digit is the low bits of n, so subtracting it cannot borrow.
+                                    n[0] -= static_cast<std::uint64_t>(digit);
+                                } else {
+                                    unsigned __int128 carry = static_cast<std::uint64_t>(-digit);
+                                    for (std::size_t j = 0; j < 3; ++j) {
+                                        carry += n[j];
+                                        n[j] = static_cast<std::uint64_t>(carry);
+                                        carry >>= 64;
+                                    }
+                                }
+                            }
+                            n[0] = (n[0] >> 1) | (n[1] << 63);
+                            n[1] = (n[1] >> 1) | (n[2] << 63);
+                            n[2] >>= 1;
+                        }
+                        return digits;
+                    }
+
+                    /// [|u|] P by double-and-add. |u| is public, so the branches reveal nothing.
+                    template<typename CurveOps>
+                    projective<CurveOps> mul_by_u_abs(const projective<CurveOps> &p) {
+                        projective<CurveOps> r = p;
+                        for (std::size_t bit = 63; bit-- > 0;) {
+                            r = dbl(r);
+                            if ((u_abs >> bit) & 1) {
+                                r = add(r, p);
+                            }
+                        }
+                        return r;
+                    }
+                }    // namespace detail
+
+                /**
+                 * The efficiently computable endomorphism of a curve, acting on the prime-order subgroup as
+                 * multiplication by a power of |u|, and how scalars split along it.
+                 */
+                template<typename CurveOps>
+                struct endomorphism;
+
+                /**
+                 * G1: (x, y) -> (beta x, y) with beta a cube root of unity acts as [-u^2]; with y negated it is
+                 * [|u|^2]. k = a + b |u|^2 with a, b < 2^128, so [k] P = [a] P + [b] ([|u|^2] P) (GLV).
+                 */
+                template<typename FieldOps>
+                struct endomorphism<g1_ops<FieldOps>> {
+                    using curve_ops = g1_ops<FieldOps>;
+                    using value_type = typename curve_ops::value_type;
+
+                    constexpr static const std::size_t dimensions = 2;
+                    constexpr static const std::size_t bits = 128;
+                    /// apply() is [|u|^u_power] on the subgroup.
+                    constexpr static const std::size_t u_power = 2;
+
+                    struct constants {
+                        value_type beta;
+                    };
+
+                    static constants load_constants() {
+                        // beta R mod p
+                        static constexpr fp381 beta = {{0x30f1361b798a64e8, 0xf3b8ddab7ece5a2a, 0x16a8ca3ac61577f7,
+                                                        0xc26a2ff874fd029b, 0x3636b76660701c6e, 0x051ba4ab241b6160}};
+                        return {FieldOps::load([](std::size_t) -> const fp381 & { return beta; })};
+                    }
+
+                    static projective<curve_ops> apply(const projective<curve_ops> &p, const constants &c) {
+                        return {FieldOps::mul(p.x, c.beta), FieldOps::sub(FieldOps::zero(), p.y), p.z};
+                    }
+
+                    static std::array<std::array<std::uint64_t, 2>, dimensions> split(const scalar256 &k) {
+                        std::array<std::uint64_t, 4> d = detail::base_u_digits<curve_ops>(k);
+                        return {combine(d[0], d[1]), combine(d[2], d[3])};
+                    }
+
+                private:
+                    /// lo + hi |u| as two 64-bit limbs; below |u|^2 < 2^128 for digits below |u|.
+                    static std::array<std::uint64_t, 2> combine(std::uint64_t lo, std::uint64_t hi) {
+                        unsigned __int128 v = static_cast<unsigned __int128>(hi) * detail::u_abs + lo;
+                        return {static_cast<std::uint64_t>(v), static_cast<std::uint64_t>(v >> 64)};
+                    }
+                };
+
+                /**
+                 * G2: psi, the untwist-Frobenius-twist map, acts as [u]; negated it is [|u|]. k splits into its
+                 * four 64-bit base |u| digits and [k] Q = sum of [d_i] ([|u|^i] Q) (GLS).
+                 */
+                template<typename FieldOps>
+                struct endomorphism<g2_ops<FieldOps>> {
+                    using curve_ops = g2_ops<FieldOps>;
+                    using value_type = typename curve_ops::value_type;
+                    using base_type = typename FieldOps::value_type;
+
+                    constexpr static const std::size_t dimensions = 4;
+                    constexpr static const std::size_t bits = 64;
+                    constexpr static const std::size_t u_power = 1;
+
+                    /// psi(x, y) = (cx conj(x), cy conj(y)) with cx = c u purely imaginary.
+                    struct constants {
+                        base_type c;
+                        value_type minus_cy;
+                    };
+
+                    static constants load_constants() {
+                        // Montgomery forms of c and of -cy's coefficients.
+                        static constexpr fp381 c = {{0x890dc9e4867545c3, 0x2af322533285a5d5, 0x50880866309b7e2c,
+                                                     0xa20d1b8c7e881024, 0x14e4f04fe2db9068, 0x14e56d3f1564853a}};
+                        static constexpr fp381 minus_cy0 = {{0x7bcfa7a25aa30fda, 0xdc17dec12a927e7c,
+                                                             0x2f088dd86b4ebef1, 0xd1ca2087da74d4a7,
+                                                             0x2da2596696cebc1d, 0x0e2b7eedbbfd87d2}};
+                        static constexpr fp381 minus_cy1 = {{0x3e2f585da55c9ad1, 0x4294213d86c18183,
+                                                             0x382844c88b623732, 0x92ad2afd19103e18,
+                                                             0x1d794e4fac7cf0b9, 0x0bd592fc7d825ec8}};
+                        return {FieldOps::load([](std::size_t) -> const fp381 & { return c; }),
+                                {FieldOps::load([](std::size_t) -> const fp381 & { return minus_cy0; }),
+                                 FieldOps::load([](std::size_t) -> const fp381 & { return minus_cy1; })}};
+                    }
+
+                    /// -psi on homogeneous coordinates: (cx conj(X) : -cy conj(Y) : conj(Z)).
+                    static projective<curve_ops> apply(const projective<curve_ops> &q, const constants &k) {
+                        // c u (x0 - x1 u) = c x1 + c x0 u
+                        value_type x = {FieldOps::mul(k.c, q.x.c1), FieldOps::mul(k.c, q.x.c0)};
+                        value_type y = curve_ops::mul(curve_ops::conjugate(q.y), k.minus_cy);
+                        return {x, y, curve_ops::conjugate(q.z)};
+                    }
+
+                    static std::array<std::array<std::uint64_t, 2>, dimensions> split(const scalar256 &k) {
+                        std::array<std::uint64_t, 4> d = detail::base_u_digits<curve_ops>(k);
+                        return {{{d[0], 0}, {d[1], 0}, {d[2], 0}, {d[3], 0}}};
+                    }
+                };
+
+                /**
+                 * [k]P for every lane, with its own point and scalar, on points of the prime-order subgroup. The
+                 * scalar is split along the endomorphism into sub-scalars of 128 (G1) or 64 (G2) bits, each
+                 * with its own table of [0..15] times the mapped point, and all of them are walked by a fixed
+                 * 4-bit window at once: a quarter (G2) or half (G1) of the doublings of a plain window. The
+                 * split is constant time, the table lookups touch every entry and the operation sequence is the
+                 * same for all scalars, so neither timing nor memory access depends on the scalars: they are
+                 * secret in transform.
+                 */
+                template<typename CurveOps>
+                projective<CurveOps> scalar_mul(const projective<CurveOps> &p, const scalar256 *scalars) {
+                    using endomorphism_type = endomorphism<CurveOps>;
+                    constexpr std::size_t window = 4;
+                    constexpr std::size_t windows = endomorphism_type::bits / window;
+                    constexpr std::size_t dimensions = endomorphism_type::dimensions;
+
+                    std::array<std::array<std::array<std::uint64_t, 2>, dimensions>, CurveOps::lanes> parts;
+                    for (std::size_t lane = 0; lane < CurveOps::lanes; ++lane) {
+                        parts[lane] = endomorphism_type::split(scalars[lane]);
+                    }
+
+                    std::array<std::array<projective<CurveOps>, 1 << window>, dimensions> tables;
+                    tables[0][0] = identity<CurveOps>();
+                    tables[0][1] = p;
+                    for (std::size_t i = 2; i < tables[0].size(); ++i) {
+                        tables[0][i] = i % 2 == 0 ? dbl(tables[0][i / 2]) : add(tables[0][i - 1], p);
+                    }
+                    const typename endomorphism_type::constants constants = endomorphism_type::load_constants();
+                    for (std::size_t d = 1; d < dimensions; ++d) {
+                        for (std::size_t i = 0; i < tables[d].size(); ++i) {
+                            tables[d][i] = endomorphism_type::apply(tables[d - 1][i], constants);
+                        }
+                    }
+
+                    projective<CurveOps> r = identity<CurveOps>();
+                    std::uint32_t digits[CurveOps::lanes];
+                    for (std::size_t w = windows; w-- > 0;) {
+                        if (w != windows - 1) {
+                            for (std::size_t i = 0; i < window; ++i) {
+                                r = dbl(r);
+                            }
+                        }
+                        std::size_t bit = w * window;
+                        for (std::size_t d = 0; d < dimensions; ++d) {
+                            for (std::size_t lane = 0; lane < CurveOps::lanes; ++lane) {
+                                digits[lane] = (parts[lane][d][bit / 64] >> (bit % 64)) & ((1 << window) - 1);
+                            }
+                            projective<CurveOps> t = tables[d][0];
+                            for (std::uint32_t k = 1; k < tables[d].size(); ++k) {
+                                t = select(CurveOps::equal(digits, k), tables[d][k], t);
+                            }
+                            r = add(r, t);
+                        }
+                    }
+                    return r;
+                }
+
+                /**
+                 * [k]P like scalar_mul, for public scalars only: the sub-scalars are recoded to width-5 NAF, the
+                 * tables hold the odd multiples [1, 3 .. 15] of the mapped points, and a dimension is added
+                 * only at its nonzero digits, about one position in six, straight from the table. Timing and
+                 * memory access follow the scalars, which is why only variable_time kernels, reached from
+                 * verification alone, call it. One lane only: lanes add wherever any of them has a digit, which
+                 * with four or eight lanes is nearly every position.
+                 */
+                template<typename CurveOps>
+                projective<CurveOps> scalar_mul_vartime(const projective<CurveOps> &p, const scalar256 *scalars) {
+                    using endomorphism_type = endomorphism<CurveOps>;
+                    constexpr std::size_t width = 5;
+                    constexpr std::size_t entries = 1 << (width - 2);
+                    constexpr std::size_t positions = endomorphism_type::bits + 1;
+                    constexpr std::size_t dimensions = endomorphism_type::dimensions;
+                    static_assert(CurveOps::lanes == 1, "variable-time multiplication is not worth it on vectors");
+
+                    std::array<std::array<std::int8_t, positions>, dimensions> digits;
+                    auto parts = endomorphism_type::split(scalars[0]);
+                    for (std::size_t d = 0; d < dimensions; ++d) {
+                        digits[d] = detail::wnaf<CurveOps, endomorphism_type::bits, width>(parts[d]);
+                    }
+
+                    std::array<std::array<projective<CurveOps>, entries>, dimensions> tables;
+                    const projective<CurveOps> p2 = dbl(p);
+                    tables[0][0] = p;
+                    for (std::size_t i = 1; i < entries; ++i) {
+                        tables[0][i] = add(tables[0][i - 1], p2);
+                    }
+                    const typename endomorphism_type::constants constants = endomorphism_type::load_constants();
+                    for (std::size_t d = 1; d < dimensions; ++d) {
+                        for (std::size_t i = 0; i < entries; ++i) {
+                            tables[d][i] = endomorphism_type::apply(tables[d - 1][i], constants);
+                        }
+                    }
+
+                    auto negate = [](const projective<CurveOps> &q) -> projective<CurveOps> {
+                        return {q.x, CurveOps::sub(CurveOps::zero(), q.y), q.z};
+                    };
+
+                    projective<CurveOps> r = identity<CurveOps>();
+                    bool started = false;
+                    for (std::size_t position = positions; position-- > 0;) {
+                        if (started) {
+                            r = dbl(r);
+                        }
+                        for (std::size_t d = 0; d < dimensions; ++d) {
+                            std::int32_t digit = digits[d][position];
+                            if (digit == 0) {
+                                continue;
+                            }
+                            // Digit 2 i + 1 is entry i.
+                            const projective<CurveOps> &t = tables[d][((digit < 0 ? -digit : digit) - 1) / 2];
+                            r = add(r, digit < 0 ? negate(t) : t);
+                            started = true;
+                        }
+                    }
+                    return r;
+                }
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_ARITHMETIC_ENDOMORPHISM_HPP
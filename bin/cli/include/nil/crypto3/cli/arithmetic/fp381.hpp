@@ -0,0 +1,405 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_ARITHMETIC_FP381_HPP
+#define CRYPTO3_CLI_ARITHMETIC_FP381_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <nil/crypto3/cli/arithmetic/montgomery.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+
+                /**
+                 * Element of the BLS12-381 base field in Montgomery form with R = 2^384: six little-endian 64-bit
+                 * limbs, always fully reduced. This is the interchange format of every kernel backend; vector
+                 * backends repack it into their own limb radix on load and back on store.
+                 */
+                struct fp381 {
+                    std::array<std::uint64_t, 6> limbs;
+                };
+
+                struct fp2_381 {
+                    fp381 c0;
+                    fp381 c1;
+                };
+
+                /// Little-endian 256-bit integer, the scalars the kernels multiply by.
+                struct scalar256 {
+                    std::array<std::uint64_t, 4> limbs;
+                };
+
+                namespace fp381_params {
+                    constexpr std::array<std::uint64_t, 6> modulus = {
+                        0xb9feffffffffaaab, 0x1eabfffeb153ffff, 0x6730d2a0f6b0f624,
+                        0x64774b84f38512bf, 0x4b1ba7b6434bacd7, 0x1a0111ea397fe69a};
+                    /// -p^-1 mod 2^64
+                    constexpr std::uint64_t inv = detail::montgomery_inv(modulus[0]);
+                    /// R mod p, the Montgomery form of one.
+                    constexpr std::array<std::uint64_t, 6> one = detail::montgomery_one(modulus);
+                    /// R^2 mod p, to enter Montgomery form.
+                    constexpr std::array<std::uint64_t, 6> r2 = detail::montgomery_r2(modulus);
+                }    // namespace fp381_params
+
+                /**
+                 * Portable field operations on fp381, one element at a time. Branch-free, so timing doesn't
+                 * depend on the values; it is the reference the vector backends are checked against and the
+                 * backend used where nothing better is available.
+                 */
+                struct fp381_portable {
+                    using value_type = fp381;
+                    /// All ones in a lane selects, all zeros doesn't.
+                    using mask_type = std::uint64_t;
+
+                    constexpr static const std::size_t lanes = 1;
+
+                    static value_type zero() {
+                        return {};
+                    }
+
+                    static value_type one() {
+                        return {fp381_params::one};
+                    }
+
+                    /// Loads and stores go through an accessor returning the element of a lane, like the vector
+                    /// backends which gather one element per lane.
+                    template<typename Accessor>
+                    static value_type load(Accessor &&element) {
+                        return element(0);
+                    }
+
+                    template<typename Accessor>
+                    static void store(const value_type &a, Accessor &&element) {
+                        element(0) = a;
+                    }
+
+                    static value_type add(const value_type &a, const value_type &b) {
+                        value_type sum;
+                        unsigned __int128 carry = 0;
+                        for (std::size_t i = 0; i < 6; ++i) {
+                            carry += static_cast<unsigned __int128>(a.limbs[i]) + b.limbs[i];
+                            sum.limbs[i] = static_cast<std::uint64_t>(carry);
+                            carry >>= 64;
+                        }
+                        // 2p < 2^384, so the sum never carries out and at most one subtraction of p is due.
+                        return subtract_modulus_if_above(sum);
+                    }
+
+                    static value_type sub(const value_type &a, const value_type &b) {
+                        value_type difference;
+                        std::uint64_t borrow = 0;
+                        for (std::size_t i = 0; i < 6; ++i) {
+                            unsigned __int128 d = static_cast<unsigned __int128>(a.limbs[i]) - b.limbs[i] - borrow;
+                            difference.limbs[i] = static_cast<std::uint64_t>(d);
+                            borrow = static_cast<std::uint64_t>(d >> 64) & 1;
+                        }
+                        std::uint64_t mask = 0 - borrow;
+                        unsigned __int128 carry = 0;
+                        for (std::size_t i = 0; i < 6; ++i) {
+                            carry += static_cast<unsigned __int128>(difference.limbs[i]) +
+                                     (fp381_params::modulus[i] & mask);
+                            difference.limbs[i] = static_cast<std::uint64_t>(carry);
+                            carry >>= 64;
+                        }
+                        return difference;
+                    }
+
+                    static value_type neg(const value_type &a) {
+                        return sub(zero(), a);
+                    }
+
+                    /// Montgomery product a * b / R, coarsely integrated operand scanning.
+                    static value_type mul(const value_type &a, const value_type &b) {
+                        std::uint64_t t[8] = {};
+                        for (std::size_t i = 0; i < 6; ++i) {
+                            unsigned __int128 carry = 0;
+                            for (std::size_t j = 0; j < 6; ++j) {
+                                carry += static_cast<unsigned __int128>(a.limbs[j]) * b.limbs[i] + t[j];
+                                t[j] = static_cast<std::uint64_t>(carry);
+                                carry >>= 64;
+                            }
+                            carry += t[6];
+                            t[6] = static_cast<std::uint64_t>(carry);
+                            t[7] = static_cast<std::uint64_t>(carry >> 64);
+
+                            std::uint64_t m = t[0] * fp381_params::inv;
+                            carry = static_cast<unsigned __int128>(m) * fp381_params::modulus[0] + t[0];
+                            carry >>= 64;
+                            for (std::size_t j = 1; j < 6; ++j) {
+                                carry += static_cast<unsigned __int128>(m) * fp381_params::modulus[j] + t[j];
+                                t[j - 1] = static_cast<std::uint64_t>(carry);
+                                carry >>= 64;
+                            }
+                            carry += t[6];
+                            t[5] = static_cast<std::uint64_t>(carry);
+                            t[6] = t[7] + static_cast<std::uint64_t>(carry >> 64);
+                        }
+                        value_type product;
+                        for (std::size_t i = 0; i < 6; ++i) {
+                            product.limbs[i] = t[i];
+                        }
+                        return subtract_modulus_if_above(product);
+                    }
+
+                    static value_type sqr(const value_type &a) {
+                        return mul(a, a);
+                    }
+
+                    /**
+                     * Double-width integers below p 2^384 for lazy reduction: sums of products are accumulated
+                     * modulo p 2^384, which keeps them congruent modulo p, and reduced once at the end.
+                     */
+                    struct wide_type {
+                        std::array<std::uint64_t, 12> limbs;
+                    };
+
+                    /// a + b without reduction, below 2p < 2^384 for reduced inputs; an input to mul_wide.
+                    static value_type add_unreduced(const value_type &a, const value_type &b) {
+                        value_type sum;
+                        unsigned __int128 carry = 0;
+                        for (std::size_t i = 0; i < 6; ++i) {
+                            carry += static_cast<unsigned __int128>(a.limbs[i]) + b.limbs[i];
+                            sum.limbs[i] = static_cast<std::uint64_t>(carry);
+                            carry >>= 64;
+                        }
+                        return sum;
+                    }
+
+                    /// The full product; inputs below 2p keep it below 4p^2 < p 2^384.
+                    static wide_type mul_wide(const value_type &a, const value_type &b) {
+                        wide_type product {};
+                        for (std::size_t i = 0; i < 6; ++i) {
+                            unsigned __int128 carry = 0;
+                            for (std::size_t j = 0; j < 6; ++j) {
+                                carry += static_cast<unsigned __int128>(a.limbs[j]) * b.limbs[i] + product.limbs[i + j];
+                                product.limbs[i + j] = static_cast<std::uint64_t>(carry);
+                                carry >>= 64;
+                            }
+                            product.limbs[i + 6] = static_cast<std::uint64_t>(carry);
+                        }
+                        return product;
+                    }
+
+                    static wide_type add_wide(const wide_type &a, const wide_type &b) {
+                        wide_type sum;
+                        unsigned __int128 carry = 0;
+                        for (std::size_t i = 0; i < 12; ++i) {
+                            carry += static_cast<unsigned __int128>(a.limbs[i]) + b.limbs[i];
+                            sum.limbs[i] = static_cast<std::uint64_t>(carry);
+                            carry >>= 64;
+                        }
+                        // Subtract p 2^384 if the sum reached it: p from the upper half, keeping the carry.
+                        wide_type reduced = sum;
+                        std::uint64_t borrow = 0;
+                        for (std::size_t i = 0; i < 6; ++i) {
+                            unsigned __int128 d =
+                                static_cast<unsigned __int128>(sum.limbs[i + 6]) - fp381_params::modulus[i] - borrow;
+                            reduced.limbs[i + 6] = static_cast<std::uint64_t>(d);
+                            borrow = static_cast<std::uint64_t>(d >> 64) & 1;
+                        }
+                        std::uint64_t keep = 0 - (borrow & ~static_cast<std::uint64_t>(carry));
+                        for (std::size_t i = 6; i < 12; ++i) {
+                            reduced.limbs[i] = (sum.limbs[i] & keep) | (reduced.limbs[i] & ~keep);
+                        }
+                        return reduced;
+                    }
+
+                    static wide_type sub_wide(const wide_type &a, const wide_type &b) {
+                        wide_type difference;
+                        std::uint64_t borrow = 0;
+                        for (std::size_t i = 0; i < 12; ++i) {
+                            unsigned __int128 d = static_cast<unsigned __int128>(a.limbs[i]) - b.limbs[i] - borrow;
+                            difference.limbs[i] = static_cast<std::uint64_t>(d);
+                            borrow = static_cast<std::uint64_t>(d >> 64) & 1;
+                        }
+                        std::uint64_t mask = 0 - borrow;
+                        unsigned __int128 carry = 0;
+                        for (std::size_t i = 6; i < 12; ++i) {
+                            carry += static_cast<unsigned __int128>(difference.limbs[i]) +
+                                     (fp381_params::modulus[i - 6] & mask);
+                            difference.limbs[i] = static_cast<std::uint64_t>(carry);
+                            carry >>= 64;
+                        }
+                        return difference;
+                    }
+
+                    /// Montgomery reduction t / R of a double-width value below p 2^384.
+                    static value_type reduce(const wide_type &t) {
+                        std::uint64_t r[13];
+                        for (std::size_t i = 0; i < 12; ++i) {
+                            r[i] = t.limbs[i];
+                        }
+                        r[12] = 0;
+                        for (std::size_t i = 0; i < 6; ++i) {
+                            std::uint64_t m = r[i] * fp381_params::inv;
+                            unsigned __int128 carry = 0;
+                            for (std::size_t j = 0; j < 6; ++j) {
+                                carry += static_cast<unsigned __int128>(m) * fp381_params::modulus[j] + r[i + j];
+                                r[i + j] = static_cast<std::uint64_t>(carry);
+                                carry >>= 64;
+                            }
+                            for (std::size_t j = i + 6; j < 13; ++j) {
+                                carry += r[j];
+                                r[j] = static_cast<std::uint64_t>(carry);
+                                carry >>= 64;
+                            }
+                        }
+                        // (t + m p) / R < (p 2^384 + 2^384 p) / 2^384 = 2p < 2^384: r[12] stays clear.
+                        value_type reduced;
+                        for (std::size_t i = 0; i < 6; ++i) {
+                            reduced.limbs[i] = r[i + 6];
+                        }
+                        return subtract_modulus_if_above(reduced);
+                    }
+
+                    static value_type select(mask_type mask, const value_type &a, const value_type &b) {
+                        value_type r;
+                        for (std::size_t i = 0; i < 6; ++i) {
+                            r.limbs[i] = (a.limbs[i] & mask) | (b.limbs[i] & ~mask);
+                        }
+                        return r;
+                    }
+
+                    /// Lanes whose digit equals k; digits holds one entry per lane.
+                    static mask_type equal(const std::uint32_t *digits, std::uint32_t k) {
+                        std::uint64_t d = digits[0] ^ k;
+                        return ((d | (0 - d)) >> 63) - 1;
+                    }
+
+                    static mask_type is_zero(const value_type &a) {
+                        std::uint64_t acc = 0;
+                        for (std::size_t i = 0; i < 6; ++i) {
+                            acc |= a.limbs[i];
+                        }
+                        return ((acc | (0 - acc)) >> 63) - 1;
+                    }
+
+                    /// a^(p - 2), by Fermat's little theorem; zero for zero. The exponent is public.
+                    static value_type inverse(const value_type &a) {
+                        std::array<std::uint64_t, 6> e = fp381_params::modulus;
+                        e[0] -= 2;
+                        value_type r = one();
+                        for (std::size_t i = 6; i-- > 0;) {
+                            for (std::size_t bit = 64; bit-- > 0;) {
+                                r = sqr(r);
+                                if ((e[i] >> bit) & 1) {
+                                    r = mul(r, a);
+                                }
+                            }
+                        }
+                        return r;
+                    }
+
+                private:
+                    static value_type subtract_modulus_if_above(const value_type &a) {
+                        value_type reduced;
+                        std::uint64_t borrow = 0;
+                        for (std::size_t i = 0; i < 6; ++i) {
+                            unsigned __int128 d =
+                                static_cast<unsigned __int128>(a.limbs[i]) - fp381_params::modulus[i] - borrow;
+                            reduced.limbs[i] = static_cast<std::uint64_t>(d);
+                            borrow = static_cast<std::uint64_t>(d >> 64) & 1;
+                        }
+                        return select(0 - borrow, a, reduced);
+                    }
+                };
+
+                /**
+                 * fp381_portable with an inversion whose running time depends on its input, several times faster
+                 * than exponentiation. For public values only: the pairing of verification and the conversions
+                 * of its points to affine coordinates.
+                 */
+                struct fp381_vartime : fp381_portable {
+                    /// Binary extended Euclid on the integer a R, then (a R)^-1 R^3 / R = a^-1 R.
+                    static value_type inverse(const value_type &a) {
+                        if (is_zero(a)) {
+                            return zero();
+                        }
+                        limbs_type u = a.limbs, v = fp381_params::modulus;
+                        value_type x1 = {{1, 0, 0, 0, 0, 0}}, x2 = zero();
+                        while (!is_one_integer(u) && !is_one_integer(v)) {
+                            while (!(u[0] & 1)) {
+                                shift_right(u);
+                                halve(x1);
+                            }
+                            while (!(v[0] & 1)) {
+                                shift_right(v);
+                                halve(x2);
+                            }
+                            if (subtract(u, v)) {
+                                x1 = sub(x1, x2);
+                            } else {
+                                subtract(v, u);
+                                x2 = sub(x2, x1);
+                            }
+                        }
+                        value_type r3 = mul({fp381_params::r2}, {fp381_params::r2});
+                        return mul(is_one_integer(u) ? x1 : x2, r3);
+                    }
+
+                private:
+                    using limbs_type = std::array<std::uint64_t, 6>;
+
+                    static bool is_one_integer(const limbs_type &a) {
+                        return a[0] == 1 && !(a[1] | a[2] | a[3] | a[4] | a[5]);
+                    }
+
+                    static void shift_right(limbs_type &a) {
+                        for (std::size_t i = 0; i < 5; ++i) {
+                            a[i] = (a[i] >> 1) | (a[i + 1] << 63);
+                        }
+                        a[5] >>= 1;
+                    }
+
+                    /// x / 2 mod p; x + p < 2^382 doesn't overflow.
+                    static void halve(value_type &x) {
+                        if (x.limbs[0] & 1) {
+                            std::uint64_t carry = 0;
+                            for (std::size_t i = 0; i < 6; ++i) {
+                                unsigned __int128 s =
+                                    static_cast<unsigned __int128>(x.limbs[i]) + fp381_params::modulus[i] + carry;
+                                x.limbs[i] = static_cast<std::uint64_t>(s);
+                                carry = static_cast<std::uint64_t>(s >> 64);
+                            }
+                        }
+                        shift_right(x.limbs);
+                    }
+
+                    /// a -= b if a >= b; whether it did.
+                    static bool subtract(limbs_type &a, const limbs_type &b) {
+                        limbs_type d;
+                        std::uint64_t borrow = 0;
+                        for (std::size_t i = 0; i < 6; ++i) {
+                            unsigned __int128 t = static_cast<unsigned __int128>(a[i]) - b[i] - borrow;
+                            d[i] = static_cast<std::uint64_t>(t);
+                            borrow = static_cast<std::uint64_t>(t >> 64) & 1;
+                        }
+                        if (borrow) {
+                            return false;
+                        }
+                        a = d;
+                        return true;
+                    }
+                };
+
+                inline fp381 to_montgomery(const std::array<std::uint64_t, 6> &integer) {
+                    return fp381_portable::mul({integer}, {fp381_params::r2});
+                }
+
+                inline std::array<std::uint64_t, 6> from_montgomery(const fp381 &a) {
+                    return fp381_portable::mul(a, {{1, 0, 0, 0, 0, 0}}).limbs;
+                }
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_ARITHMETIC_FP381_HPP
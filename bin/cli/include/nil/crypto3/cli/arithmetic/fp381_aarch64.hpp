@@ -0,0 +1,68 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_ARITHMETIC_FP381_AARCH64_HPP
+#define CRYPTO3_CLI_ARITHMETIC_FP381_AARCH64_HPP
+
+#if !defined(__aarch64__)
+#error "fp381_aarch64.hpp requires AArch64"
+#endif
+
+#include <cstdint>
+
+#include <nil/crypto3/cli/arithmetic/fp381.hpp>
+
+// src/arithmetic/fp381_aarch64.S
+extern "C" {
+void crypto3_cli_fp381_mul_aarch64(std::uint64_t *r, const std::uint64_t *a, const std::uint64_t *b);
+void crypto3_cli_fp381_add_aarch64(std::uint64_t *r, const std::uint64_t *a, const std::uint64_t *b);
+void crypto3_cli_fp381_sub_aarch64(std::uint64_t *r, const std::uint64_t *a, const std::uint64_t *b);
+}
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+
+                /**
+                 * The portable backend with its arithmetic replaced by AArch64 assembly built on MUL/UMULH
+                 * pairs. NEON has no 64 x 64 bit multiplier, and a 32-bit radix costs more than it gains on
+                 * cores with a fully pipelined UMULH, so this stays scalar. Same representation and results as
+                 * fp381_portable, one element at a time.
+                 */
+                struct fp381_aarch64 : fp381_portable {
+                    static value_type add(const value_type &a, const value_type &b) {
+                        value_type r;
+                        crypto3_cli_fp381_add_aarch64(r.limbs.data(), a.limbs.data(), b.limbs.data());
+                        return r;
+                    }
+
+                    static value_type sub(const value_type &a, const value_type &b) {
+                        value_type r;
+                        crypto3_cli_fp381_sub_aarch64(r.limbs.data(), a.limbs.data(), b.limbs.data());
+                        return r;
+                    }
+
+                    static value_type neg(const value_type &a) {
+                        return sub(zero(), a);
+                    }
+
+                    static value_type mul(const value_type &a, const value_type &b) {
+                        value_type r;
+                        crypto3_cli_fp381_mul_aarch64(r.limbs.data(), a.limbs.data(), b.limbs.data());
+                        return r;
+                    }
+
+                    static value_type sqr(const value_type &a) {
+                        return mul(a, a);
+                    }
+                };
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_ARITHMETIC_FP381_AARCH64_HPP
@@ -0,0 +1,236 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_ARITHMETIC_FP381_AVX2_HPP
+#define CRYPTO3_CLI_ARITHMETIC_FP381_AVX2_HPP
+
+#if !defined(__AVX2__)
+#error "fp381_avx2.hpp must be compiled with AVX2 enabled"
+#endif
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <immintrin.h>
+
+#include <nil/crypto3/cli/arithmetic/fp381.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+
+                /**
+                 * Four independent field elements per operation, one per 64-bit lane. AVX2 only multiplies
+                 * 32 x 32 bits, so elements are held in radix 2^29 with fourteen limbs: products are 58 bits
+                 * and a whole Montgomery round accumulates in 64-bit lanes without carrying. Elements are kept
+                 * in Montgomery form with R' = 2^406 and fully reduced between operations.
+                 */
+                struct fp381_avx2 {
+                    constexpr static const std::size_t limbs = 14;
+                    constexpr static const std::size_t lanes = 4;
+
+                    struct value_type {
+                        __m256i limb[limbs];
+                    };
+                    /// All ones in a lane selects, all zeros doesn't.
+                    using mask_type = __m256i;
+
+                    static value_type zero() {
+                        value_type r;
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            r.limb[i] = _mm256_setzero_si256();
+                        }
+                        return r;
+                    }
+
+                    static value_type one() {
+                        // R' mod p
+                        return constant({0x03a9fb84, 0x0ba00690, 0x071288f1, 0x0f59bcc5, 0x126cb614, 0x0585bf36,
+                                         0x1b85ac3d, 0x1cf856fa, 0x1891ecbd, 0x1a7eec05, 0x155a88f0, 0x0741ac6d,
+                                         0x1317c30f, 0x00000009});
+                    }
+
+                    /// Gathers one element per lane, repacking 6 x 64 to 14 x 29 bits and rescaling R to R'.
+                    template<typename Accessor>
+                    static value_type load(Accessor &&element) {
+                        alignas(32) std::uint64_t columns[limbs][lanes];
+                        for (std::size_t lane = 0; lane < lanes; ++lane) {
+                            const fp381 &a = element(lane);
+                            for (std::size_t i = 0; i < limbs; ++i) {
+                                columns[i][lane] = bits(a, 29 * i);
+                            }
+                        }
+                        value_type r;
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            r.limb[i] = _mm256_load_si256(reinterpret_cast<const __m256i *>(columns[i]));
+                        }
+                        // a R * 2^428 / R' = a R'
+                        return mul(r, constant({0x1fddebbd, 0x1a4f5474, 0x0291f399, 0x14d03b3c, 0x0f6cad2c,
+                                                0x1b4cabca, 0x1592827c, 0x021c6ac7, 0x1ec52a84, 0x16fd5ec4,
+                                                0x0c960da6, 0x0fd2af6b, 0x13263591, 0x0000000b}));
+                    }
+
+                    template<typename Accessor>
+                    static void store(const value_type &a, Accessor &&element) {
+                        // a R' * 2^384 / R' = a R
+                        value_type r = mul(a, constant({0x0002fffd, 0x10480000, 0x0300009d, 0x08001788, 0x158baebf,
+                                                        0x0c2ba9e3, 0x1d157d22, 0x0a6e0a4a, 0x0d77ce58, 0x1d12b763,
+                                                        0x1701c6a5, 0x1501c926, 0x1f65ec3f, 0x0000000a}));
+                        alignas(32) std::uint64_t columns[limbs][lanes];
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            _mm256_store_si256(reinterpret_cast<__m256i *>(columns[i]), r.limb[i]);
+                        }
+                        for (std::size_t lane = 0; lane < lanes; ++lane) {
+                            fp381 &out = element(lane);
+                            out.limbs = {};
+                            for (std::size_t i = 0; i < limbs; ++i) {
+                                std::size_t bit = 29 * i;
+                                out.limbs[bit / 64] |= columns[i][lane] << (bit % 64);
+                                if (bit % 64 > 35 && bit / 64 + 1 < 6) {
+                                    out.limbs[bit / 64 + 1] |= columns[i][lane] >> (64 - bit % 64);
+                                }
+                            }
+                        }
+                    }
+
+                    static value_type add(const value_type &a, const value_type &b) {
+                        value_type r;
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            r.limb[i] = _mm256_add_epi64(a.limb[i], b.limb[i]);
+                        }
+                        return subtract_modulus_if_above(normalize(r));
+                    }
+
+                    static value_type sub(const value_type &a, const value_type &b) {
+                        value_type r;
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            r.limb[i] = _mm256_sub_epi64(a.limb[i], b.limb[i]);
+                        }
+                        r = normalize(r);
+                        // A negative difference leaves the top limb negative; add p back in those lanes.
+                        __m256i negative = _mm256_cmpgt_epi64(_mm256_setzero_si256(), r.limb[limbs - 1]);
+                        value_type modulus = constant(modulus_limbs());
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            r.limb[i] = _mm256_add_epi64(r.limb[i], _mm256_and_si256(negative, modulus.limb[i]));
+                        }
+                        return normalize(r);
+                    }
+
+                    /**
+                     * Montgomery product a * b / R', operand scanning. A column receives at most 28 products
+                     * below 2^58, so sums fit in 64 bits and only the limb being shifted out is carried.
+                     */
+                    static value_type mul(const value_type &a, const value_type &b) {
+                        const __m256i mask = _mm256_set1_epi64x(limb_mask);
+                        const __m256i inv = _mm256_set1_epi64x(0x1ffcfffd);
+                        const value_type modulus = constant(modulus_limbs());
+
+                        __m256i t[limbs];
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            t[i] = _mm256_setzero_si256();
+                        }
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            for (std::size_t j = 0; j < limbs; ++j) {
+                                t[j] = _mm256_add_epi64(t[j], _mm256_mul_epu32(a.limb[i], b.limb[j]));
+                            }
+                            __m256i m = _mm256_and_si256(_mm256_mul_epu32(t[0], inv), mask);
+                            for (std::size_t j = 0; j < limbs; ++j) {
+                                t[j] = _mm256_add_epi64(t[j], _mm256_mul_epu32(m, modulus.limb[j]));
+                            }
+                            __m256i carry = _mm256_srli_epi64(t[0], 29);
+                            for (std::size_t j = 0; j + 1 < limbs; ++j) {
+                                t[j] = t[j + 1];
+                            }
+                            t[0] = _mm256_add_epi64(t[0], carry);
+                            t[limbs - 1] = _mm256_setzero_si256();
+                        }
+
+                        value_type r;
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            r.limb[i] = t[i];
+                        }
+                        return subtract_modulus_if_above(normalize(r));
+                    }
+
+                    static value_type sqr(const value_type &a) {
+                        return mul(a, a);
+                    }
+
+                    static value_type select(const mask_type &mask, const value_type &a, const value_type &b) {
+                        value_type r;
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            r.limb[i] = _mm256_blendv_epi8(b.limb[i], a.limb[i], mask);
+                        }
+                        return r;
+                    }
+
+                    static mask_type equal(const std::uint32_t *digits, std::uint32_t k) {
+                        __m256i d = _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i *>(digits)));
+                        return _mm256_cmpeq_epi64(d, _mm256_set1_epi64x(k));
+                    }
+
+                private:
+                    constexpr static const std::uint64_t limb_mask = (std::uint64_t(1) << 29) - 1;
+
+                    static constexpr std::array<std::uint64_t, limbs> modulus_limbs() {
+                        return {0x1fffaaab, 0x0ff7ffff, 0x14ffffee, 0x17fffd62, 0x0f6241ea, 0x09507b58, 0x0afd9cc3,
+                                0x109e70a2, 0x1764774b, 0x121a5d66, 0x12c6e9ed, 0x12ffcd34, 0x00111ea3, 0x0000000d};
+                    }
+
+                    static value_type constant(const std::array<std::uint64_t, limbs> &limb_values) {
+                        value_type r;
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            r.limb[i] = _mm256_set1_epi64x(static_cast<long long>(limb_values[i]));
+                        }
+                        return r;
+                    }
+
+                    static std::uint64_t bits(const fp381 &a, std::size_t bit) {
+                        std::uint64_t v = a.limbs[bit / 64] >> (bit % 64);
+                        if (bit % 64 > 35 && bit / 64 + 1 < 6) {
+                            v |= a.limbs[bit / 64 + 1] << (64 - bit % 64);
+                        }
+                        return v & limb_mask;
+                    }
+
+                    /// AVX2 has no 64-bit arithmetic shift; limbs are below 2^62 in magnitude, so shifting the
+                    /// biased value and removing the bias is exact.
+                    static __m256i shift_signed(__m256i a) {
+                        const __m256i bias = _mm256_set1_epi64x(std::int64_t(1) << 62);
+                        const __m256i bias_shifted = _mm256_set1_epi64x(std::int64_t(1) << 33);
+                        return _mm256_sub_epi64(_mm256_srli_epi64(_mm256_add_epi64(a, bias), 29), bias_shifted);
+                    }
+
+                    /// Propagates carries (or borrows) so every limb but the top is 29 bits.
+                    static value_type normalize(value_type a) {
+                        const __m256i mask = _mm256_set1_epi64x(limb_mask);
+                        for (std::size_t i = 0; i + 1 < limbs; ++i) {
+                            a.limb[i + 1] = _mm256_add_epi64(a.limb[i + 1], shift_signed(a.limb[i]));
+                            a.limb[i] = _mm256_and_si256(a.limb[i], mask);
+                        }
+                        return a;
+                    }
+
+                    /// For normalized a < 2p.
+                    static value_type subtract_modulus_if_above(const value_type &a) {
+                        const value_type modulus = constant(modulus_limbs());
+                        value_type d;
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            d.limb[i] = _mm256_sub_epi64(a.limb[i], modulus.limb[i]);
+                        }
+                        d = normalize(d);
+                        __m256i below = _mm256_cmpgt_epi64(_mm256_setzero_si256(), d.limb[limbs - 1]);
+                        return select(below, a, d);
+                    }
+                };
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_ARITHMETIC_FP381_AVX2_HPP
@@ -0,0 +1,226 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_ARITHMETIC_FP381_AVX512IFMA_HPP
+#define CRYPTO3_CLI_ARITHMETIC_FP381_AVX512IFMA_HPP
+
+#if !defined(__AVX512F__) || !defined(__AVX512VL__) || !defined(__AVX512IFMA__)
+#error "fp381_avx512ifma.hpp must be compiled with AVX-512 F, VL and IFMA enabled"
+#endif
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <immintrin.h>
+
+#include <nil/crypto3/cli/arithmetic/fp381.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+
+                /**
+                 * Eight independent field elements per operation, one per 64-bit lane, in radix 2^52 with
+                 * eight limbs, so every limb product is a single 52-bit multiply-accumulate. Elements are kept
+                 * in Montgomery form with R' = 2^416 and fully reduced between operations.
+                 */
+                struct fp381_avx512ifma {
+                    constexpr static const std::size_t limbs = 8;
+                    constexpr static const std::size_t lanes = 8;
+
+                    struct value_type {
+                        __m512i limb[limbs];
+                    };
+                    using mask_type = __mmask8;
+
+                    static value_type zero() {
+                        value_type r;
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            r.limb[i] = _mm512_setzero_si512();
+                        }
+                        return r;
+                    }
+
+                    static value_type one() {
+                        // R' mod p
+                        return constant({0x6480ea8e9b9af, 0x65766c8fe444f, 0x8b540fea96f7d, 0x3b2ee82efd422,
+                                         0xa6723e5f0ade5, 0xff6eb6fdd4230, 0xe06ef23c24a25, 0x0000000014c8e});
+                    }
+
+                    /// Gathers one element per lane, repacking 6 x 64 to 8 x 52 bits and rescaling R to R'.
+                    template<typename Accessor>
+                    static value_type load(Accessor &&element) {
+                        alignas(64) std::uint64_t columns[limbs][lanes];
+                        for (std::size_t lane = 0; lane < lanes; ++lane) {
+                            const fp381 &a = element(lane);
+                            for (std::size_t i = 0; i < limbs; ++i) {
+                                columns[i][lane] = bits(a, 52 * i);
+                            }
+                        }
+                        value_type r;
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            r.limb[i] = _mm512_load_si512(columns[i]);
+                        }
+                        // a R * 2^448 / R' = a R'
+                        return mul(r, constant({0x7fde37dba9366, 0x4e27525bc342b, 0x1f5b1e9778489, 0xb872b2b91b9dc,
+                                                0xb206f497dfcaf, 0x4137cc89a9b0b, 0xd9d20d7e39959, 0x000000000411c}));
+                    }
+
+                    template<typename Accessor>
+                    static void store(const value_type &a, Accessor &&element) {
+                        // a R' * 2^384 / R' = a R
+                        value_type r = mul(a, constant({0x900000002fffd, 0x0bc40c0002760, 0x3c758baebf400,
+                                                        0x57455f4898575, 0xd77ce58537052, 0x071a97a256ec6,
+                                                        0xec3fa80e4935c, 0x0000000015f65}));
+                        alignas(64) std::uint64_t columns[limbs][lanes];
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            _mm512_store_si512(columns[i], r.limb[i]);
+                        }
+                        for (std::size_t lane = 0; lane < lanes; ++lane) {
+                            fp381 &out = element(lane);
+                            out.limbs = {};
+                            for (std::size_t i = 0; i < limbs; ++i) {
+                                std::size_t bit = 52 * i;
+                                out.limbs[bit / 64] |= columns[i][lane] << (bit % 64);
+                                if (bit % 64 > 12 && bit / 64 + 1 < 6) {
+                                    out.limbs[bit / 64 + 1] |= columns[i][lane] >> (64 - bit % 64);
+                                }
+                            }
+                        }
+                    }
+
+                    static value_type add(const value_type &a, const value_type &b) {
+                        value_type r;
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            r.limb[i] = _mm512_add_epi64(a.limb[i], b.limb[i]);
+                        }
+                        return subtract_modulus_if_above(normalize(r));
+                    }
+
+                    static value_type sub(const value_type &a, const value_type &b) {
+                        value_type r;
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            r.limb[i] = _mm512_sub_epi64(a.limb[i], b.limb[i]);
+                        }
+                        r = normalize(r);
+                        // A negative difference leaves the top limb negative; add p back in those lanes.
+                        __mmask8 negative = _mm512_cmplt_epi64_mask(r.limb[limbs - 1], _mm512_setzero_si512());
+                        value_type modulus = constant(modulus_limbs());
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            r.limb[i] = _mm512_mask_add_epi64(r.limb[i], negative, r.limb[i], modulus.limb[i]);
+                        }
+                        return normalize(r);
+                    }
+
+                    /**
+                     * Montgomery product a * b / R', operand scanning. Column sums stay below 2^58 without
+                     * intermediate carries, so only the limb being shifted out is carried on each round.
+                     */
+                    static value_type mul(const value_type &a, const value_type &b) {
+                        const __m512i mask = _mm512_set1_epi64(limb_mask);
+                        const __m512i inv = _mm512_set1_epi64(0x3fffcfffcfffd);
+                        const value_type modulus = constant(modulus_limbs());
+
+                        __m512i t[limbs + 1];
+                        for (std::size_t i = 0; i <= limbs; ++i) {
+                            t[i] = _mm512_setzero_si512();
+                        }
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            for (std::size_t j = 0; j < limbs; ++j) {
+                                t[j] = _mm512_madd52lo_epu64(t[j], a.limb[i], b.limb[j]);
+                                t[j + 1] = _mm512_madd52hi_epu64(t[j + 1], a.limb[i], b.limb[j]);
+                            }
+                            __m512i m = _mm512_and_si512(_mm512_madd52lo_epu64(_mm512_setzero_si512(), t[0], inv),
+                                                         mask);
+                            for (std::size_t j = 0; j < limbs; ++j) {
+                                t[j] = _mm512_madd52lo_epu64(t[j], m, modulus.limb[j]);
+                                t[j + 1] = _mm512_madd52hi_epu64(t[j + 1], m, modulus.limb[j]);
+                            }
+                            t[1] = _mm512_add_epi64(t[1], _mm512_srli_epi64(t[0], 52));
+                            for (std::size_t j = 0; j < limbs; ++j) {
+                                t[j] = t[j + 1];
+                            }
+                            t[limbs] = _mm512_setzero_si512();
+                        }
+
+                        value_type r;
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            r.limb[i] = t[i];
+                        }
+                        return subtract_modulus_if_above(normalize(r));
+                    }
+
+                    static value_type sqr(const value_type &a) {
+                        return mul(a, a);
+                    }
+
+                    static value_type select(mask_type mask, const value_type &a, const value_type &b) {
+                        value_type r;
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            r.limb[i] = _mm512_mask_blend_epi64(mask, b.limb[i], a.limb[i]);
+                        }
+                        return r;
+                    }
+
+                    static mask_type equal(const std::uint32_t *digits, std::uint32_t k) {
+                        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(digits));
+                        return _mm256_cmpeq_epi32_mask(d, _mm256_set1_epi32(static_cast<int>(k)));
+                    }
+
+                private:
+                    constexpr static const std::uint64_t limb_mask = (std::uint64_t(1) << 52) - 1;
+
+                    static constexpr std::array<std::uint64_t, limbs> modulus_limbs() {
+                        return {0xeffffffffaaab, 0xfeb153ffffb9f, 0x6b0f6241eabff, 0x12bf6730d2a0f,
+                                0x764774b84f385, 0x1ba7b6434bacd, 0x1ea397fe69a4b, 0x000000001a011};
+                    }
+
+                    static value_type constant(const std::array<std::uint64_t, limbs> &limb_values) {
+                        value_type r;
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            r.limb[i] = _mm512_set1_epi64(static_cast<long long>(limb_values[i]));
+                        }
+                        return r;
+                    }
+
+                    static std::uint64_t bits(const fp381 &a, std::size_t bit) {
+                        std::uint64_t v = a.limbs[bit / 64] >> (bit % 64);
+                        if (bit % 64 > 12 && bit / 64 + 1 < 6) {
+                            v |= a.limbs[bit / 64 + 1] << (64 - bit % 64);
+                        }
+                        return v & limb_mask;
+                    }
+
+                    /// Propagates carries (or borrows, with arithmetic shifts) so every limb but the top is 52 bits.
+                    static value_type normalize(value_type a) {
+                        const __m512i mask = _mm512_set1_epi64(limb_mask);
+                        for (std::size_t i = 0; i + 1 < limbs; ++i) {
+                            a.limb[i + 1] = _mm512_add_epi64(a.limb[i + 1], _mm512_srai_epi64(a.limb[i], 52));
+                            a.limb[i] = _mm512_and_si512(a.limb[i], mask);
+                        }
+                        return a;
+                    }
+
+                    /// For normalized a < 2p.
+                    static value_type subtract_modulus_if_above(const value_type &a) {
+                        const value_type modulus = constant(modulus_limbs());
+                        value_type d;
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            d.limb[i] = _mm512_sub_epi64(a.limb[i], modulus.limb[i]);
+                        }
+                        d = normalize(d);
+                        __mmask8 below = _mm512_cmplt_epi64_mask(d.limb[limbs - 1], _mm512_setzero_si512());
+                        return select(below, a, d);
+                    }
+                };
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_ARITHMETIC_FP381_AVX512IFMA_HPP
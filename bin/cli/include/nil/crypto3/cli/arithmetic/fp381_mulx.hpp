@@ -0,0 +1,70 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_ARITHMETIC_FP381_MULX_HPP
+#define CRYPTO3_CLI_ARITHMETIC_FP381_MULX_HPP
+
+#if !defined(__x86_64__)
+#error "fp381_mulx.hpp requires x86-64"
+#endif
+
+#include <cstdint>
+
+#include <nil/crypto3/cli/arithmetic/fp381.hpp>
+
+// src/arithmetic/fp381_x86_64.S; mul and sqr need BMI2 and ADX.
+extern "C" {
+void crypto3_cli_fp381_mul_mulx(std::uint64_t *r, const std::uint64_t *a, const std::uint64_t *b);
+void crypto3_cli_fp381_sqr_mulx(std::uint64_t *r, const std::uint64_t *a);
+void crypto3_cli_fp381_add_x86_64(std::uint64_t *r, const std::uint64_t *a, const std::uint64_t *b);
+void crypto3_cli_fp381_sub_x86_64(std::uint64_t *r, const std::uint64_t *a, const std::uint64_t *b);
+}
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+
+                /**
+                 * The portable backend with its arithmetic replaced by assembly: MULX multiplies without
+                 * touching the flags, so ADCX and ADOX run the two carry chains of a Montgomery round side by
+                 * side. Same representation and results as fp381_portable, one element at a time.
+                 */
+                struct fp381_mulx : fp381_portable {
+                    static value_type add(const value_type &a, const value_type &b) {
+                        value_type r;
+                        crypto3_cli_fp381_add_x86_64(r.limbs.data(), a.limbs.data(), b.limbs.data());
+                        return r;
+                    }
+
+                    static value_type sub(const value_type &a, const value_type &b) {
+                        value_type r;
+                        crypto3_cli_fp381_sub_x86_64(r.limbs.data(), a.limbs.data(), b.limbs.data());
+                        return r;
+                    }
+
+                    static value_type neg(const value_type &a) {
+                        return sub(zero(), a);
+                    }
+
+                    static value_type mul(const value_type &a, const value_type &b) {
+                        value_type r;
+                        crypto3_cli_fp381_mul_mulx(r.limbs.data(), a.limbs.data(), b.limbs.data());
+                        return r;
+                    }
+
+                    static value_type sqr(const value_type &a) {
+                        value_type r;
+                        crypto3_cli_fp381_sqr_mulx(r.limbs.data(), a.limbs.data());
+                        return r;
+                    }
+                };
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_ARITHMETIC_FP381_MULX_HPP
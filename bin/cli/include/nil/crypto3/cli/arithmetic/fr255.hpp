@@ -0,0 +1,146 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_ARITHMETIC_FR255_HPP
+#define CRYPTO3_CLI_ARITHMETIC_FR255_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <nil/crypto3/cli/arithmetic/fp381.hpp>
+#include <nil/crypto3/cli/arithmetic/montgomery.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+
+                /// Element of the BLS12-381 scalar field in Montgomery form with R = 2^256, always fully reduced.
+                struct fr255 {
+                    std::array<std::uint64_t, 4> limbs;
+                };
+
+                namespace fr255_params {
+                    constexpr std::array<std::uint64_t, 4> modulus = {0xffffffff00000001, 0x53bda402fffe5bfe,
+                                                                      0x3339d80809a1d805, 0x73eda753299d7d48};
+                    /// -r^-1 mod 2^64
+                    constexpr std::uint64_t inv = detail::montgomery_inv(modulus[0]);
+                    /// R mod r, the Montgomery form of one.
+                    constexpr std::array<std::uint64_t, 4> one = detail::montgomery_one(modulus);
+                    /// R^2 mod r, to enter Montgomery form.
+                    constexpr std::array<std::uint64_t, 4> r2 = detail::montgomery_r2(modulus);
+                }    // namespace fr255_params
+
+                /**
+                 * Scalar field operations with the limb count and every constant fixed at compile time, so the
+                 * loops unroll and inline where the general multiprecision field of the library can't. Branch-free
+                 * like fp381_portable: the scalars are powers of the contributor's secrets.
+                 */
+                struct fr255_portable {
+                    using value_type = fr255;
+
+                    static value_type zero() {
+                        return {};
+                    }
+
+                    static value_type one() {
+                        return {fr255_params::one};
+                    }
+
+                    static value_type add(const value_type &a, const value_type &b) {
+                        value_type sum;
+                        unsigned __int128 carry = 0;
+                        for (std::size_t i = 0; i < 4; ++i) {
+                            carry += static_cast<unsigned __int128>(a.limbs[i]) + b.limbs[i];
+                            sum.limbs[i] = static_cast<std::uint64_t>(carry);
+                            carry >>= 64;
+                        }
+                        // 2r < 2^256, so the sum never carries out.
+                        return subtract_modulus_if_above(sum);
+                    }
+
+                    /// Montgomery product a * b / R, coarsely integrated operand scanning.
+                    static value_type mul(const value_type &a, const value_type &b) {
+                        std::uint64_t t[6] = {};
+                        for (std::size_t i = 0; i < 4; ++i) {
+                            unsigned __int128 carry = 0;
+                            for (std::size_t j = 0; j < 4; ++j) {
+                                carry += static_cast<unsigned __int128>(a.limbs[j]) * b.limbs[i] + t[j];
+                                t[j] = static_cast<std::uint64_t>(carry);
+                                carry >>= 64;
+                            }
+                            carry += t[4];
+                            t[4] = static_cast<std::uint64_t>(carry);
+                            t[5] = static_cast<std::uint64_t>(carry >> 64);
+
+                            std::uint64_t m = t[0] * fr255_params::inv;
+                            carry = static_cast<unsigned __int128>(m) * fr255_params::modulus[0] + t[0];
+                            carry >>= 64;
+                            for (std::size_t j = 1; j < 4; ++j) {
+                                carry += static_cast<unsigned __int128>(m) * fr255_params::modulus[j] + t[j];
+                                t[j - 1] = static_cast<std::uint64_t>(carry);
+                                carry >>= 64;
+                            }
+                            carry += t[4];
+                            t[3] = static_cast<std::uint64_t>(carry);
+                            t[4] = t[5] + static_cast<std::uint64_t>(carry >> 64);
+                        }
+                        value_type product;
+                        for (std::size_t i = 0; i < 4; ++i) {
+                            product.limbs[i] = t[i];
+                        }
+                        return subtract_modulus_if_above(product);
+                    }
+
+                    static value_type sqr(const value_type &a) {
+                        return mul(a, a);
+                    }
+
+                    /// a^exponent by square-and-multiply; the exponent is public, a need not be.
+                    static value_type pow(const value_type &a, std::uint64_t exponent) {
+                        value_type r = one();
+                        for (std::size_t bit = 64; bit-- > 0;) {
+                            r = sqr(r);
+                            if ((exponent >> bit) & 1) {
+                                r = mul(r, a);
+                            }
+                        }
+                        return r;
+                    }
+
+                    /// The Montgomery form of an integer below r.
+                    static value_type to_montgomery(const scalar256 &k) {
+                        return mul({k.limbs}, {fr255_params::r2});
+                    }
+
+                    static scalar256 from_montgomery(const value_type &a) {
+                        return {mul(a, {{1, 0, 0, 0}}).limbs};
+                    }
+
+                private:
+                    static value_type subtract_modulus_if_above(const value_type &a) {
+                        value_type reduced;
+                        std::uint64_t borrow = 0;
+                        for (std::size_t i = 0; i < 4; ++i) {
+                            unsigned __int128 d =
+                                static_cast<unsigned __int128>(a.limbs[i]) - fr255_params::modulus[i] - borrow;
+                            reduced.limbs[i] = static_cast<std::uint64_t>(d);
+                            borrow = static_cast<std::uint64_t>(d >> 64) & 1;
+                        }
+                        std::uint64_t mask = 0 - borrow;
+                        for (std::size_t i = 0; i < 4; ++i) {
+                            reduced.limbs[i] = (a.limbs[i] & mask) | (reduced.limbs[i] & ~mask);
+                        }
+                        return reduced;
+                    }
+                };
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_ARITHMETIC_FR255_HPP
@@ -0,0 +1,129 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_ARITHMETIC_KERNELS_HPP
+#define CRYPTO3_CLI_ARITHMETIC_KERNELS_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <nil/crypto3/cli/arithmetic/fp381.hpp>
+#include <nil/crypto3/cli/arithmetic/point_columns.hpp>
+#include <nil/crypto3/cli/arithmetic/projective.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+
+                /**
+                 * Timing policies of scalar multiplication. constant_time is for secret scalars, the powers of
+                 * tau in a contribution; variable_time skips the work public scalars allow and serves
+                 * verification, whose inputs are all public. The policy is part of the type of the kernels a
+                 * caller names, so secret data cannot reach the variable-time code by accident.
+                 */
+                struct constant_time { };
+                struct variable_time { };
+
+                /**
+                 * Batched BLS12-381 point arithmetic of one backend. Every backend is compiled in its own
+                 * translation unit with the instruction set it needs, and only this table crosses the boundary,
+                 * so the rest of the program never runs instructions the CPU may lack.
+                 */
+                struct kernel_table {
+                    const char *name;
+
+                    /// points[i] = [scalars[i]] points[i]
+                    void (*g1_mul)(point_columns<g1_raw> &points, const scalar256 *scalars);
+                    void (*g2_mul)(point_columns<g2_raw> &points, const scalar256 *scalars);
+
+                    /// Sum of [scalars[i]] points[i].
+                    g1_raw (*g1_multi_mul)(const g1_raw *points, const scalar256 *scalars, std::size_t count);
+                    g2_raw (*g2_multi_mul)(const g2_raw *points, const scalar256 *scalars, std::size_t count);
+
+                    /// The same in variable time, for public points and scalars only.
+                    void (*g1_mul_vartime)(point_columns<g1_raw> &points, const scalar256 *scalars);
+                    void (*g2_mul_vartime)(point_columns<g2_raw> &points, const scalar256 *scalars);
+                    g1_raw (*g1_multi_mul_vartime)(const g1_raw *points, const scalar256 *scalars, std::size_t count);
+                    g2_raw (*g2_multi_mul_vartime)(const g2_raw *points, const scalar256 *scalars, std::size_t count);
+
+                    /// Index of the first point off the curve or outside the prime-order subgroup; count if none.
+                    std::size_t (*g1_validate)(const g1_raw *points, std::size_t count);
+                    std::size_t (*g2_validate)(const g2_raw *points, std::size_t count);
+
+                    /// Index of the first point off the curve, subgroup aside; count if none.
+                    std::size_t (*g1_on_curve)(const g1_raw *points, std::size_t count);
+                    std::size_t (*g2_on_curve)(const g2_raw *points, std::size_t count);
+
+                    /// r[i] = a[i] op b[i] in the base field; r may be a or b. What the points are computed with,
+                    /// exposed for testing the backends against each other.
+                    void (*fp_add)(fp381 *r, const fp381 *a, const fp381 *b, std::size_t count);
+                    void (*fp_sub)(fp381 *r, const fp381 *a, const fp381 *b, std::size_t count);
+                    void (*fp_mul)(fp381 *r, const fp381 *a, const fp381 *b, std::size_t count);
+                    void (*fp_sqr)(fp381 *r, const fp381 *a, std::size_t count);
+                };
+
+                extern const kernel_table portable_kernels;
+#if defined(CRYPTO3_CLI_HAS_MULX)
+                extern const kernel_table mulx_kernels;
+#endif
+#if defined(CRYPTO3_CLI_HAS_AARCH64)
+                extern const kernel_table aarch64_kernels;
+#endif
+#if defined(CRYPTO3_CLI_HAS_AVX2)
+                extern const kernel_table avx2_kernels;
+#endif
+#if defined(CRYPTO3_CLI_HAS_AVX512IFMA)
+                extern const kernel_table avx512ifma_kernels;
+#endif
+
+                /// Instruction set extensions the backends depend on, as reported by CPUID and enabled by the OS.
+                struct cpu_features {
+                    bool bmi2 = false;
+                    bool adx = false;
+                    bool avx2 = false;
+                    bool avx512ifma = false;
+                };
+
+                cpu_features detect_cpu_features();
+
+                /// The standard generators of G1 and G2, with Z = 1.
+                g1_raw g1_generator();
+                g2_raw g2_generator();
+
+                /// Known-answer test of every entry of a backend; true if all of them agree.
+                bool self_test(const kernel_table &table);
+
+                /**
+                 * The backends compiled in, fastest first, and what happened to each at startup: the first one the
+                 * CPU supports and which passes its self-test is selected. The portable backend is always last,
+                 * so a backend that fails its self-test costs speed, never correctness.
+                 */
+                struct kernel_dispatch {
+                    enum class status { unsupported, untested, passed, failed };
+
+                    struct candidate {
+                        const kernel_table *table;
+                        status result;
+                    };
+
+                    cpu_features features;
+                    std::vector<candidate> candidates;
+                    const kernel_table *selected;
+                };
+
+                /// Probes the CPU and self-tests the backends the first time it is called; throws
+                /// std::runtime_error if even the portable backend fails.
+                const kernel_dispatch &dispatch();
+
+                /// The selected backend.
+                const kernel_table &kernels();
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_ARITHMETIC_KERNELS_HPP
@@ -0,0 +1,75 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_ARITHMETIC_MONTGOMERY_HPP
+#define CRYPTO3_CLI_ARITHMETIC_MONTGOMERY_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+                namespace detail {
+
+                    /// -m^-1 mod 2^64 for odd m0, by Newton's iteration doubling the correct low bits each step.
+                    constexpr std::uint64_t montgomery_inv(std::uint64_t m0) {
+                        std::uint64_t x = 1;
+                        for (std::size_t i = 0; i < 6; ++i) {
+                            x *= 2 - m0 * x;
+                        }
+                        return 0 - x;
+                    }
+
+                    /// 2^exponent mod m by repeated doubling, for a modulus of Limbs 64-bit limbs.
+                    template<std::size_t Limbs>
+                    constexpr std::array<std::uint64_t, Limbs> pow2_mod(const std::array<std::uint64_t, Limbs> &m,
+                                                                      std::size_t exponent) {
+                        std::array<std::uint64_t, Limbs> r {};
+                        r[0] = 1;
+                        for (std::size_t e = 0; e < exponent; ++e) {
+                            std::uint64_t carry = r[Limbs - 1] >> 63;
+                            for (std::size_t i = Limbs; i-- > 1;) {
+                                r[i] = (r[i] << 1) | (r[i - 1] >> 63);
+                            }
+                            r[0] <<= 1;
+
+                            std::array<std::uint64_t, Limbs> d {};
+                            std::uint64_t borrow = 0;
+                            for (std::size_t i = 0; i < Limbs; ++i) {
+                                d[i] = r[i] - m[i] - borrow;
+                                borrow = (r[i] < m[i]) || (r[i] - m[i] < borrow);
+                            }
+                            // 2r < 2m, so one subtraction reduces it: due if 2r carried out or didn't borrow.
+                            if (carry || !borrow) {
+                                r = d;
+                            }
+                        }
+                        return r;
+                    }
+
+                    /// R = 2^(64 Limbs) mod m, the Montgomery form of one.
+                    template<std::size_t Limbs>
+                    constexpr std::array<std::uint64_t, Limbs>
+                        montgomery_one(const std::array<std::uint64_t, Limbs> &m) {
+                        return pow2_mod(m, 64 * Limbs);
+                    }
+
+                    /// R^2 mod m, which enters Montgomery form in a single product.
+                    template<std::size_t Limbs>
+                    constexpr std::array<std::uint64_t, Limbs>
+                        montgomery_r2(const std::array<std::uint64_t, Limbs> &m) {
+                        return pow2_mod(m, 128 * Limbs);
+                    }
+                }    // namespace detail
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_ARITHMETIC_MONTGOMERY_HPP
@@ -0,0 +1,97 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_ARITHMETIC_NATIVE_HPP
+#define CRYPTO3_CLI_ARITHMETIC_NATIVE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <nil/crypto3/algebra/curves/bls12.hpp>
+
+#include <nil/crypto3/cli/arithmetic/pairing.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+
+                constexpr std::size_t g1_native_size = 96;
+                constexpr std::size_t g2_native_size = 192;
+
+                /**
+                 * Identifies how this build holds fp381 in memory, which is how it writes native records. The
+                 * kernel backends all share the representation, so it doesn't change with the instruction set
+                 * picked at startup.
+                 */
+                std::uint64_t native_fingerprint();
+
+                /**
+                 * Whether records written under fingerprint can be loaded: those of a build like this one, and
+                 * those of the reference layout, little-endian limbs with R = 2^384, which is what every
+                 * little-endian build of this version writes.
+                 */
+                bool native_readable(std::uint64_t fingerprint);
+
+                /**
+                 * Affine BLS12-381 points in the Montgomery form of fp381, x then y, c0 before c1 in G2, each
+                 * coordinate as six 64-bit limbs the way the writing build holds them. The point at infinity is
+                 * all zeros, which no point on either curve is. Only meant for files that stay with whoever
+                 * wrote them: nothing is converted on the way out, nor on the way in by a build with the same
+                 * fingerprint.
+                 */
+                void store_native(const g1_affine *points, std::size_t count, std::uint8_t *out);
+                void store_native(const g2_affine *points, std::size_t count, std::uint8_t *out);
+
+                /**
+                 * False if a coordinate isn't fully reduced. same_build, for records written under this build's
+                 * native_fingerprint, copies the limbs as they are; otherwise they are read in the reference
+                 * layout and converted. Curve and subgroup membership are left to validation.
+                 */
+                bool load_native(const std::uint8_t *in, std::size_t count, g1_affine *points, bool same_build);
+                bool load_native(const std::uint8_t *in, std::size_t count, g2_affine *points, bool same_build);
+
+                /**
+                 * Native records of a point type, over the affine storage of compact_points, so a chunk cache
+                 * fills straight from them. The primary template has none.
+                 */
+                template<typename GroupValueType>
+                struct native_points {
+                    constexpr static const bool available = false;
+                };
+
+                namespace detail {
+                    template<typename AffineType, std::size_t Size>
+                    struct bls12_381_native_points {
+                        using storage_type = AffineType;
+
+                        constexpr static const bool available = true;
+                        constexpr static const std::size_t size = Size;
+
+                        static void store(const storage_type *points, std::size_t count, std::uint8_t *out) {
+                            store_native(points, count, out);
+                        }
+
+                        static bool load(const std::uint8_t *in, std::size_t count, storage_type *points,
+                                         bool same_build) {
+                            return load_native(in, count, points, same_build);
+                        }
+                    };
+                }    // namespace detail
+
+                template<>
+                struct native_points<typename algebra::curves::bls12<381>::template g1_type<>::value_type>
+                    : detail::bls12_381_native_points<g1_affine, g1_native_size> { };
+
+                template<>
+                struct native_points<typename algebra::curves::bls12<381>::template g2_type<>::value_type>
+                    : detail::bls12_381_native_points<g2_affine, g2_native_size> { };
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_ARITHMETIC_NATIVE_HPP
@@ -0,0 +1,98 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_ARITHMETIC_PAIRING_HPP
+#define CRYPTO3_CLI_ARITHMETIC_PAIRING_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <nil/crypto3/cli/arithmetic/fp381.hpp>
+#include <nil/crypto3/cli/arithmetic/projective.hpp>
+#include <nil/crypto3/cli/arithmetic/tower.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+
+                struct g1_affine {
+                    fp381 x;
+                    fp381 y;
+                    bool infinity;
+                };
+
+                struct g2_affine {
+                    fp2_381 x;
+                    fp2_381 y;
+                    bool infinity;
+                };
+
+                /// A line of the Miller loop, before its evaluation at the G1 argument.
+                struct g2_line {
+                    fp2_381 c0;
+                    fp2_381 c1;
+                    fp2_381 c2;
+                };
+
+                /**
+                 * The lines of the Miller loop of a G2 point in the order the loop consumes them. They depend on
+                 * the G2 argument alone, so a point paired many times is walked through the doubling and addition
+                 * steps once and each later Miller loop only evaluates its lines.
+                 */
+                struct g2_prepared {
+                    std::vector<g2_line> lines;
+                    bool infinity;
+                };
+
+                g1_affine to_affine(const g1_raw &p);
+                g2_affine to_affine(const g2_raw &q);
+
+                /// The same for count points at the cost of a single inversion.
+                void to_affine(const g1_raw *p, g1_affine *affine, std::size_t count);
+                void to_affine(const g2_raw *q, g2_affine *affine, std::size_t count);
+
+                g2_prepared prepare(const g2_affine &q);
+
+                /**
+                 * The optimal ate pairing of BLS12-381 split in its two halves. multi_miller_loop runs the Miller
+                 * loops of e(p[i], q[i]) in lockstep, sharing every squaring of the accumulator, and returns
+                 * their product; products of Miller loops over several batches combine with
+                 * multiply_miller_loops, and one final_exponentiation then yields the product of the pairings.
+                 * Pairs with the identity on either side contribute one.
+                 */
+                fp12_381 multi_miller_loop(const g1_affine *p, const g2_affine *q, std::size_t count);
+
+                /// The same product over prepared G2 points, which are only referenced.
+                fp12_381 multi_miller_loop(const g1_affine *p, const g2_prepared *const *q, std::size_t count);
+
+                fp12_381 multiply_miller_loops(const fp12_381 &a, const fp12_381 &b);
+
+                fp12_381 final_exponentiation(const fp12_381 &f);
+
+                bool is_one(const fp12_381 &f);
+
+                /// The product of the pairings e(p[i], q[i]) is one; a single final exponentiation for all of them.
+                bool pairing_product_is_one(const g1_affine *p, const g2_affine *q, std::size_t count);
+
+                /// Average nanoseconds per operation of the pairing and the tower beneath it, for the bench command.
+                struct pairing_timings {
+                    double fp2_mul;
+                    double fp12_mul;
+                    double fp12_sqr;
+                    double fp12_cyclotomic_sqr;
+                    double miller_loop;
+                    double final_exponentiation;
+                };
+
+                /// Times iterations pairings of the generators, and a hundred times as many Fp2 and Fp12 operations.
+                pairing_timings time_pairing(std::size_t iterations);
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_ARITHMETIC_PAIRING_HPP
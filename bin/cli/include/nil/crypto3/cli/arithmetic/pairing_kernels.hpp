@@ -0,0 +1,192 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_ARITHMETIC_PAIRING_KERNELS_HPP
+#define CRYPTO3_CLI_ARITHMETIC_PAIRING_KERNELS_HPP
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include <nil/crypto3/algebra/algorithms/pair.hpp>
+#include <nil/crypto3/algebra/curves/bls12.hpp>
+
+#include <nil/crypto3/cli/arena.hpp>
+#include <nil/crypto3/cli/arithmetic/curve_kernels.hpp>
+#include <nil/crypto3/cli/arithmetic/pairing.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+
+                /**
+                 * Products of pairings with a single final exponentiation. Miller loops of separate batches, run
+                 * on separate threads for instance, are multiplied together before the one final
+                 * exponentiation which decides whether the product is one. G2 points paired repeatedly are
+                 * prepared once and passed by pointer. The primary template uses the curve's own pairing, for
+                 * which a prepared point is the point itself.
+                 */
+                template<typename CurveType>
+                struct pairing_kernels {
+                    using g1_value_type = typename CurveType::template g1_type<>::value_type;
+                    using g2_value_type = typename CurveType::template g2_type<>::value_type;
+                    using miller_loop_type = typename CurveType::gt_type::value_type;
+                    using prepared_type = g2_value_type;
+
+                    static miller_loop_type one() {
+                        return miller_loop_type::one();
+                    }
+
+                    static prepared_type prepare(const g2_value_type &q) {
+                        return q;
+                    }
+
+                    /// Product of the Miller loops of e(p[i], q[i]).
+                    static miller_loop_type miller_loop(const g1_value_type *p,
+                                                        const g2_value_type *q,
+                                                        std::size_t count) {
+                        miller_loop_type f = miller_loop_type::one();
+                        for (std::size_t i = 0; i < count; ++i) {
+                            f = f * algebra::pair<CurveType>(p[i], q[i]);
+                        }
+                        return f;
+                    }
+
+                    static miller_loop_type miller_loop(const g1_value_type *p,
+                                                        const prepared_type *const *q,
+                                                        std::size_t count) {
+                        miller_loop_type f = miller_loop_type::one();
+                        for (std::size_t i = 0; i < count; ++i) {
+                            f = f * algebra::pair<CurveType>(p[i], *q[i]);
+                        }
+                        return f;
+                    }
+
+                    static miller_loop_type multiply(const miller_loop_type &a, const miller_loop_type &b) {
+                        return a * b;
+                    }
+
+                    /// The final exponentiation of f is one.
+                    static bool is_one(const miller_loop_type &f) {
+                        return algebra::final_exponentiation<CurveType>(f) == miller_loop_type::one();
+                    }
+                };
+
+                /// BLS12-381 runs on the pairing of the arithmetic layer, fed through the point conversions of the
+                /// scalar multiplication kernels.
+                template<>
+                struct pairing_kernels<algebra::curves::bls12<381>> {
+                    using curve_type = algebra::curves::bls12<381>;
+                    using g1_value_type = typename curve_type::template g1_type<>::value_type;
+                    using g2_value_type = typename curve_type::template g2_type<>::value_type;
+                    using miller_loop_type = fp12_381;
+                    using prepared_type = g2_prepared;
+
+                    static miller_loop_type one() {
+                        return fp12_ops<fp381_portable>::store(fp12_ops<fp381_portable>::one());
+                    }
+
+                    static prepared_type prepare(const g2_value_type &q) {
+                        return arithmetic::prepare(to_affine(curve_kernels<curve_type>::to_raw(q)));
+                    }
+
+                    static miller_loop_type miller_loop(const g1_value_type *p,
+                                                        const g2_value_type *q,
+                                                        std::size_t count) {
+                        scratch_scope scratch;
+                        scratch_vector<g1_raw> p_raw(count, scratch.resource());
+                        scratch_vector<g2_raw> q_raw(count, scratch.resource());
+                        for (std::size_t i = 0; i < count; ++i) {
+                            p_raw[i] = curve_kernels<curve_type>::to_raw(p[i]);
+                            q_raw[i] = curve_kernels<curve_type>::to_raw(q[i]);
+                        }
+                        scratch_vector<g1_affine> p_affine(count, scratch.resource());
+                        scratch_vector<g2_affine> q_affine(count, scratch.resource());
+                        to_affine(p_raw.data(), p_affine.data(), count);
+                        to_affine(q_raw.data(), q_affine.data(), count);
+                        return multi_miller_loop(p_affine.data(), q_affine.data(), count);
+                    }
+
+                    static miller_loop_type miller_loop(const g1_value_type *p,
+                                                        const prepared_type *const *q,
+                                                        std::size_t count) {
+                        scratch_scope scratch;
+                        scratch_vector<g1_raw> p_raw(count, scratch.resource());
+                        for (std::size_t i = 0; i < count; ++i) {
+                            p_raw[i] = curve_kernels<curve_type>::to_raw(p[i]);
+                        }
+                        scratch_vector<g1_affine> p_affine(count, scratch.resource());
+                        to_affine(p_raw.data(), p_affine.data(), count);
+                        return multi_miller_loop(p_affine.data(), q, count);
+                    }
+
+                    static miller_loop_type multiply(const miller_loop_type &a, const miller_loop_type &b) {
+                        return multiply_miller_loops(a, b);
+                    }
+
+                    static bool is_one(const miller_loop_type &f) {
+                        return arithmetic::is_one(final_exponentiation(f));
+                    }
+                };
+
+                /**
+                 * Prepared G2 points shared by the pairings of a process, such as the generator and the public
+                 * key elements of a contribution, which verification pairs against again and again. The least
+                 * recently used point is dropped beyond capacity; a dropped point stays alive as long as a
+                 * pairing still holds it.
+                 */
+                template<typename CurveType>
+                class prepared_g2_cache {
+                public:
+                    using pairing_type = pairing_kernels<CurveType>;
+                    using g2_value_type = typename pairing_type::g2_value_type;
+                    using prepared_type = typename pairing_type::prepared_type;
+
+                    explicit prepared_g2_cache(std::size_t capacity) : capacity(capacity) {
+                    }
+
+                    std::shared_ptr<const prepared_type> get(const g2_value_type &q) {
+                        {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            for (auto it = lru.begin(); it != lru.end(); ++it) {
+                                if (it->first == q) {
+                                    lru.splice(lru.begin(), lru, it);
+                                    return it->second;
+                                }
+                            }
+                        }
+
+                        // Prepared outside the lock; two threads racing on the same point both prepare it.
+                        auto prepared = std::make_shared<const prepared_type>(pairing_type::prepare(q));
+                        std::lock_guard<std::mutex> lock(mutex);
+                        lru.emplace_front(q, prepared);
+                        if (lru.size() > capacity) {
+                            lru.pop_back();
+                        }
+                        return prepared;
+                    }
+
+                private:
+                    std::size_t capacity;
+                    std::mutex mutex;
+                    std::list<std::pair<g2_value_type, std::shared_ptr<const prepared_type>>> lru;
+                };
+
+                /// The process-wide cache of prepared G2 points of a curve.
+                template<typename CurveType>
+                prepared_g2_cache<CurveType> &prepared_g2() {
+                    static prepared_g2_cache<CurveType> cache(64);
+                    return cache;
+                }
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_ARITHMETIC_PAIRING_KERNELS_HPP
@@ -0,0 +1,82 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_ARITHMETIC_POINT_CODEC_HPP
+#define CRYPTO3_CLI_ARITHMETIC_POINT_CODEC_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <nil/crypto3/algebra/curves/bls12.hpp>
+
+#include <nil/crypto3/cli/arena.hpp>
+#include <nil/crypto3/cli/arithmetic/compact_points.hpp>
+#include <nil/crypto3/cli/arithmetic/compressed.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+
+                /**
+                 * Fixed-size encoding of whole batches of points, bypassing the per-point field framework of
+                 * the library's marshalling. The primary template has none; callers keep to the generic path
+                 * unless available is true.
+                 */
+                template<typename GroupValueType>
+                struct point_codec {
+                    constexpr static const bool available = false;
+                };
+
+                namespace detail {
+                    template<typename GroupValueType, std::size_t Size>
+                    struct bls12_381_point_codec {
+                        using compact_type = compact_points<GroupValueType>;
+                        using affine_type = typename compact_type::storage_type;
+
+                        constexpr static const bool available = true;
+                        constexpr static const std::size_t size = Size;
+
+                        /// Encodes count points into count consecutive records; one inversion for the batch.
+                        static void encode(const GroupValueType *points, std::size_t count, std::uint8_t *out,
+                                           byte_order order) {
+                            scratch_scope scratch;
+                            scratch_vector<affine_type> affine(count, scratch.resource());
+                            compact_type::compress(points, affine.data(), count);
+                            encode_compressed(affine.data(), count, out, order);
+                        }
+
+                        /// False, leaving points unspecified, if a record doesn't hold a point on the curve.
+                        static bool decode(const std::uint8_t *in, std::size_t count, GroupValueType *points,
+                                           byte_order order) {
+                            scratch_scope scratch;
+                            scratch_vector<affine_type> affine(count, scratch.resource());
+                            if (!decode_compressed(in, count, affine.data(), order)) {
+                                return false;
+                            }
+                            for (std::size_t i = 0; i < count; ++i) {
+                                points[i] = compact_type::expand(affine[i]);
+                            }
+                            return true;
+                        }
+                    };
+                }    // namespace detail
+
+                template<>
+                struct point_codec<typename algebra::curves::bls12<381>::template g1_type<>::value_type>
+                    : detail::bls12_381_point_codec<
+                          typename algebra::curves::bls12<381>::template g1_type<>::value_type, g1_compressed_size> { };
+
+                template<>
+                struct point_codec<typename algebra::curves::bls12<381>::template g2_type<>::value_type>
+                    : detail::bls12_381_point_codec<
+                          typename algebra::curves::bls12<381>::template g2_type<>::value_type, g2_compressed_size> { };
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_ARITHMETIC_POINT_CODEC_HPP
@@ -0,0 +1,117 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_ARITHMETIC_POINT_COLUMNS_HPP
+#define CRYPTO3_CLI_ARITHMETIC_POINT_COLUMNS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include <nil/crypto3/cli/huge_pages.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+
+                /**
+                 * Points stored as a structure of arrays: the k-th 64-bit word of every point forms one contiguous
+                 * column, so the same limb of consecutive points is adjacent in memory rather than a point's
+                 * size apart. Columns start on 64-byte boundaries and are padded to a multiple of eight points,
+                 * the widest group of lanes, so a group never straddles a cache line it doesn't fill. Columns of a
+                 * whole power vector take huge pages. get, set and operator[] give the element-wise access of an
+                 * array of RawType.
+                 */
+                template<typename RawType>
+                class point_columns {
+                    static_assert(std::is_trivially_copyable<RawType>::value &&
+                                      sizeof(RawType) % sizeof(std::uint64_t) == 0,
+                                  "points must be made of 64-bit words");
+
+                public:
+                    using value_type = RawType;
+
+                    constexpr static const std::size_t alignment = 64;
+                    constexpr static const std::size_t words = sizeof(RawType) / sizeof(std::uint64_t);
+                    constexpr static const std::size_t group = alignment / sizeof(std::uint64_t);
+
+                    /// Proxy for a point, converting to and assigning from RawType.
+                    class reference {
+                    public:
+                        reference(point_columns &columns, std::size_t i) : columns(columns), i(i) {
+                        }
+
+                        operator RawType() const {
+                            return columns.get(i);
+                        }
+
+                        reference &operator=(const RawType &p) {
+                            columns.set(i, p);
+                            return *this;
+                        }
+
+                    private:
+                        point_columns &columns;
+                        std::size_t i;
+                    };
+
+                    explicit point_columns(std::size_t count = 0) :
+                        count(count), stride((count + group - 1) / group * group), data(words * stride) {
+                    }
+
+                    std::size_t size() const {
+                        return count;
+                    }
+
+                    RawType get(std::size_t i) const {
+                        std::uint64_t point_words[words];
+                        for (std::size_t w = 0; w < words; ++w) {
+                            point_words[w] = data[w * stride + i];
+                        }
+                        RawType p;
+                        std::memcpy(&p, point_words, sizeof(p));
+                        return p;
+                    }
+
+                    void set(std::size_t i, const RawType &p) {
+                        std::uint64_t point_words[words];
+                        std::memcpy(point_words, &p, sizeof(p));
+                        for (std::size_t w = 0; w < words; ++w) {
+                            data[w * stride + i] = point_words[w];
+                        }
+                    }
+
+                    RawType operator[](std::size_t i) const {
+                        return get(i);
+                    }
+
+                    reference operator[](std::size_t i) {
+                        return {*this, i};
+                    }
+
+                    /// The w-th word of every point, 64-byte aligned.
+                    const std::uint64_t *column(std::size_t w) const {
+                        return data.data() + w * stride;
+                    }
+
+                    std::uint64_t *column(std::size_t w) {
+                        return data.data() + w * stride;
+                    }
+
+                private:
+                    std::size_t count;
+                    std::size_t stride;
+                    std::vector<std::uint64_t, huge_page_allocator<std::uint64_t>> data;
+                };
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_ARITHMETIC_POINT_COLUMNS_HPP
@@ -0,0 +1,246 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_ARITHMETIC_PROJECTIVE_HPP
+#define CRYPTO3_CLI_ARITHMETIC_PROJECTIVE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <nil/crypto3/cli/arithmetic/fp381.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+
+                /// Point in homogeneous projective coordinates (X : Y : Z), x = X / Z and y = Y / Z.
+                template<typename FieldElement>
+                struct projective_raw {
+                    FieldElement x;
+                    FieldElement y;
+                    FieldElement z;
+                };
+
+                using g1_raw = projective_raw<fp381>;
+                using g2_raw = projective_raw<fp2_381>;
+
+                /**
+                 * Quadratic extension Fp[u] / (u^2 + 1) over any base field backend, lane for lane. Loads and
+                 * stores go through accessors, so the same code gathers from arrays of fp2_381 or of points.
+                 */
+                template<typename FieldOps>
+                struct fp2_ops {
+                    using base_type = typename FieldOps::value_type;
+                    using mask_type = typename FieldOps::mask_type;
+
+                    struct value_type {
+                        base_type c0;
+                        base_type c1;
+                    };
+
+                    constexpr static const std::size_t lanes = FieldOps::lanes;
+
+                    static value_type zero() {
+                        return {FieldOps::zero(), FieldOps::zero()};
+                    }
+
+                    static value_type one() {
+                        return {FieldOps::one(), FieldOps::zero()};
+                    }
+
+                    template<typename Accessor>
+                    static value_type load(Accessor &&element) {
+                        return {FieldOps::load([&](std::size_t lane) -> const fp381 & { return element(lane).c0; }),
+                                FieldOps::load([&](std::size_t lane) -> const fp381 & { return element(lane).c1; })};
+                    }
+
+                    template<typename Accessor>
+                    static void store(const value_type &a, Accessor &&element) {
+                        FieldOps::store(a.c0, [&](std::size_t lane) -> fp381 & { return element(lane).c0; });
+                        FieldOps::store(a.c1, [&](std::size_t lane) -> fp381 & { return element(lane).c1; });
+                    }
+
+                    static value_type add(const value_type &a, const value_type &b) {
+                        return {FieldOps::add(a.c0, b.c0), FieldOps::add(a.c1, b.c1)};
+                    }
+
+                    static value_type sub(const value_type &a, const value_type &b) {
+                        return {FieldOps::sub(a.c0, b.c0), FieldOps::sub(a.c1, b.c1)};
+                    }
+
+                    static value_type neg(const value_type &a) {
+                        return {FieldOps::sub(FieldOps::zero(), a.c0), FieldOps::sub(FieldOps::zero(), a.c1)};
+                    }
+
+                    /// The Frobenius map of Fp2.
+                    static value_type conjugate(const value_type &a) {
+                        return {a.c0, FieldOps::sub(FieldOps::zero(), a.c1)};
+                    }
+
+                    /// (u + 1) (c0 + c1 u) = (c0 - c1) + (c0 + c1) u
+                    static value_type mul_by_nonresidue(const value_type &a) {
+                        return {FieldOps::sub(a.c0, a.c1), FieldOps::add(a.c0, a.c1)};
+                    }
+
+                    /// Karatsuba: three base field products instead of four.
+                    static value_type mul(const value_type &a, const value_type &b) {
+                        base_type t0 = FieldOps::mul(a.c0, b.c0);
+                        base_type t1 = FieldOps::mul(a.c1, b.c1);
+                        base_type t2 = FieldOps::mul(FieldOps::add(a.c0, a.c1), FieldOps::add(b.c0, b.c1));
+                        return {FieldOps::sub(t0, t1), FieldOps::sub(FieldOps::sub(t2, t0), t1)};
+                    }
+
+                    /// (c0 + c1 u)^2 = (c0 + c1)(c0 - c1) + 2 c0 c1 u
+                    static value_type sqr(const value_type &a) {
+                        base_type t = FieldOps::mul(a.c0, a.c1);
+                        return {FieldOps::mul(FieldOps::add(a.c0, a.c1), FieldOps::sub(a.c0, a.c1)),
+                                FieldOps::add(t, t)};
+                    }
+
+                    static value_type select(const mask_type &mask, const value_type &a, const value_type &b) {
+                        return {FieldOps::select(mask, a.c0, b.c0), FieldOps::select(mask, a.c1, b.c1)};
+                    }
+
+                    static mask_type equal(const std::uint32_t *digits, std::uint32_t k) {
+                        return FieldOps::equal(digits, k);
+                    }
+                };
+
+                /// y^2 = x^3 + 4 over Fp.
+                template<typename FieldOps>
+                struct g1_ops : FieldOps {
+                    using raw_type = g1_raw;
+                    using element_type = fp381;
+                    using value_type = typename FieldOps::value_type;
+
+                    static value_type mul_by_b3(const value_type &a) {
+                        value_type a4 = FieldOps::add(a, a);
+                        a4 = FieldOps::add(a4, a4);
+                        return FieldOps::add(FieldOps::add(a4, a4), a4);
+                    }
+                };
+
+                /// y^2 = x^3 + 4 (u + 1) over Fp2.
+                template<typename FieldOps>
+                struct g2_ops : fp2_ops<FieldOps> {
+                    using base_ops = fp2_ops<FieldOps>;
+                    using raw_type = g2_raw;
+                    using element_type = fp2_381;
+                    using value_type = typename base_ops::value_type;
+
+                    /// 12 (u + 1) (c0 + c1 u) = 12 (c0 - c1) + 12 (c0 + c1) u
+                    static value_type mul_by_b3(const value_type &a) {
+                        value_type t = base_ops::mul_by_nonresidue(a);
+                        value_type t4 = base_ops::add(t, t);
+                        t4 = base_ops::add(t4, t4);
+                        return base_ops::add(base_ops::add(t4, t4), t4);
+                    }
+                };
+
+                template<typename CurveOps>
+                struct projective {
+                    using value_type = typename CurveOps::value_type;
+
+                    value_type x;
+                    value_type y;
+                    value_type z;
+                };
+
+                template<typename CurveOps>
+                projective<CurveOps> identity() {
+                    return {CurveOps::zero(), CurveOps::one(), CurveOps::zero()};
+                }
+
+                /// Gathers lanes points through an accessor returning the raw point of each lane.
+                template<typename CurveOps, typename Accessor>
+                projective<CurveOps> load(Accessor &&point) {
+                    return {CurveOps::load([&](std::size_t lane) -> const auto & { return point(lane).x; }),
+                            CurveOps::load([&](std::size_t lane) -> const auto & { return point(lane).y; }),
+                            CurveOps::load([&](std::size_t lane) -> const auto & { return point(lane).z; })};
+                }
+
+                template<typename CurveOps, typename Accessor>
+                void store(const projective<CurveOps> &p, Accessor &&point) {
+                    CurveOps::store(p.x, [&](std::size_t lane) -> auto & { return point(lane).x; });
+                    CurveOps::store(p.y, [&](std::size_t lane) -> auto & { return point(lane).y; });
+                    CurveOps::store(p.z, [&](std::size_t lane) -> auto & { return point(lane).z; });
+                }
+
+                template<typename CurveOps>
+                projective<CurveOps> select(const typename CurveOps::mask_type &mask,
+                                            const projective<CurveOps> &p,
+                                            const projective<CurveOps> &q) {
+                    return {CurveOps::select(mask, p.x, q.x), CurveOps::select(mask, p.y, q.y),
+                            CurveOps::select(mask, p.z, q.z)};
+                }
+
+                /**
+                 * Complete addition for a = 0 (Renes, Costello, Batina 2016, algorithm 7). It is correct for
+                 * every pair of inputs, the identity and doubling included, so lanes never diverge and there
+                 * is nothing to branch on.
+                 */
+                template<typename CurveOps>
+                projective<CurveOps> add(const projective<CurveOps> &p, const projective<CurveOps> &q) {
+                    using ops = CurveOps;
+                    using value_type = typename CurveOps::value_type;
+
+                    value_type t0 = ops::mul(p.x, q.x);
+                    value_type t1 = ops::mul(p.y, q.y);
+                    value_type t2 = ops::mul(p.z, q.z);
+                    value_type t3 = ops::mul(ops::add(p.x, p.y), ops::add(q.x, q.y));
+                    t3 = ops::sub(t3, ops::add(t0, t1));
+                    value_type t4 = ops::mul(ops::add(p.y, p.z), ops::add(q.y, q.z));
+                    t4 = ops::sub(t4, ops::add(t1, t2));
+                    value_type y3 = ops::mul(ops::add(p.x, p.z), ops::add(q.x, q.z));
+                    y3 = ops::sub(y3, ops::add(t0, t2));
+                    t0 = ops::add(ops::add(t0, t0), t0);
+                    t2 = ops::mul_by_b3(t2);
+                    value_type z3 = ops::add(t1, t2);
+                    t1 = ops::sub(t1, t2);
+                    y3 = ops::mul_by_b3(y3);
+
+                    projective<CurveOps> r;
+                    r.x = ops::sub(ops::mul(t3, t1), ops::mul(t4, y3));
+                    r.y = ops::add(ops::mul(t1, z3), ops::mul(y3, t0));
+                    r.z = ops::add(ops::mul(z3, t4), ops::mul(t0, t3));
+                    return r;
+                }
+
+                /// Complete doubling for a = 0 (Renes, Costello, Batina 2016, algorithm 9).
+                template<typename CurveOps>
+                projective<CurveOps> dbl(const projective<CurveOps> &p) {
+                    using ops = CurveOps;
+                    using value_type = typename CurveOps::value_type;
+
+                    value_type t0 = ops::sqr(p.y);
+                    value_type z3 = ops::add(t0, t0);
+                    z3 = ops::add(z3, z3);
+                    z3 = ops::add(z3, z3);
+                    value_type t1 = ops::mul(p.y, p.z);
+                    value_type t2 = ops::mul_by_b3(ops::sqr(p.z));
+                    value_type x3 = ops::mul(t2, z3);
+                    value_type y3 = ops::add(t0, t2);
+                    z3 = ops::mul(t1, z3);
+                    t2 = ops::add(ops::add(t2, t2), t2);
+                    t0 = ops::sub(t0, t2);
+                    y3 = ops::add(x3, ops::mul(t0, y3));
+                    t1 = ops::mul(p.x, p.y);
+                    x3 = ops::mul(t0, t1);
+
+                    projective<CurveOps> r;
+                    r.x = ops::add(x3, x3);
+                    r.y = y3;
+                    r.z = z3;
+                    return r;
+                }
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_ARITHMETIC_PROJECTIVE_HPP
@@ -0,0 +1,484 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_ARITHMETIC_TOWER_HPP
+#define CRYPTO3_CLI_ARITHMETIC_TOWER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <nil/crypto3/cli/arithmetic/fp381.hpp>
+#include <nil/crypto3/cli/arithmetic/projective.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+
+                /// Fp6 = Fp2[v] / (v^3 - (u + 1)).
+                struct fp6_381 {
+                    fp2_381 c0;
+                    fp2_381 c1;
+                    fp2_381 c2;
+                };
+
+                /// Fp12 = Fp6[w] / (w^2 - v), where the pairing takes its values.
+                struct fp12_381 {
+                    fp6_381 c0;
+                    fp6_381 c1;
+                };
+
+                namespace detail {
+                    /// Multiplies by an Fp2 constant kept in Montgomery form.
+                    template<typename Fp2Ops>
+                    typename Fp2Ops::value_type mul_by_constant(const typename Fp2Ops::value_type &a,
+                                                                const fp2_381 &constant) {
+                        return Fp2Ops::mul(a, Fp2Ops::load([&](std::size_t) -> const fp2_381 & { return constant; }));
+                    }
+                }    // namespace detail
+
+                /**
+                 * Fp2 as the tower uses it, with lazy reduction: products come out at double width, sums and
+                 * differences of them stay there, and a Montgomery reduction per coefficient happens once at
+                 * the end. FieldOps provides the double-width operations.
+                 */
+                template<typename FieldOps>
+                struct fp2_tower_ops : fp2_ops<FieldOps> {
+                    using base_ops = fp2_ops<FieldOps>;
+                    using value_type = typename base_ops::value_type;
+                    using wide_base_type = typename FieldOps::wide_type;
+
+                    struct wide_type {
+                        wide_base_type c0;
+                        wide_base_type c1;
+                    };
+
+                    /// Karatsuba on unreduced sums: three double-width products and no reduction.
+                    static wide_type mul_wide(const value_type &a, const value_type &b) {
+                        wide_base_type t0 = FieldOps::mul_wide(a.c0, b.c0);
+                        wide_base_type t1 = FieldOps::mul_wide(a.c1, b.c1);
+                        wide_base_type t2 = FieldOps::mul_wide(FieldOps::add_unreduced(a.c0, a.c1),
+                                                               FieldOps::add_unreduced(b.c0, b.c1));
+                        return {FieldOps::sub_wide(t0, t1), FieldOps::sub_wide(FieldOps::sub_wide(t2, t0), t1)};
+                    }
+
+                    /// (c0 + c1 u)^2 = (c0 + c1)(c0 - c1) + 2 c0 c1 u
+                    static wide_type sqr_wide(const value_type &a) {
+                        return {FieldOps::mul_wide(FieldOps::add_unreduced(a.c0, a.c1), FieldOps::sub(a.c0, a.c1)),
+                                FieldOps::mul_wide(FieldOps::add_unreduced(a.c0, a.c0), a.c1)};
+                    }
+
+                    static wide_type add_wide(const wide_type &a, const wide_type &b) {
+                        return {FieldOps::add_wide(a.c0, b.c0), FieldOps::add_wide(a.c1, b.c1)};
+                    }
+
+                    static wide_type sub_wide(const wide_type &a, const wide_type &b) {
+                        return {FieldOps::sub_wide(a.c0, b.c0), FieldOps::sub_wide(a.c1, b.c1)};
+                    }
+
+                    static wide_type mul_by_nonresidue_wide(const wide_type &a) {
+                        return {FieldOps::sub_wide(a.c0, a.c1), FieldOps::add_wide(a.c0, a.c1)};
+                    }
+
+                    static value_type reduce(const wide_type &a) {
+                        return {FieldOps::reduce(a.c0), FieldOps::reduce(a.c1)};
+                    }
+
+                    static value_type mul(const value_type &a, const value_type &b) {
+                        return reduce(mul_wide(a, b));
+                    }
+
+                    static value_type sqr(const value_type &a) {
+                        return reduce(sqr_wide(a));
+                    }
+                };
+
+                /**
+                 * Cubic extension of Fp2, one element at a time: the tower only serves the pairing, whose Miller
+                 * loops are sequential. Products are accumulated at double width and reduced once per
+                 * coefficient.
+                 */
+                template<typename FieldOps>
+                struct fp6_ops {
+                    using fp2 = fp2_tower_ops<FieldOps>;
+                    using fp2_type = typename fp2::value_type;
+                    using fp2_wide_type = typename fp2::wide_type;
+
+                    static_assert(FieldOps::lanes == 1, "the extension tower works on one element at a time");
+
+                    struct value_type {
+                        fp2_type c0;
+                        fp2_type c1;
+                        fp2_type c2;
+                    };
+
+                    struct wide_type {
+                        fp2_wide_type c0;
+                        fp2_wide_type c1;
+                        fp2_wide_type c2;
+                    };
+
+                    static value_type zero() {
+                        return {fp2::zero(), fp2::zero(), fp2::zero()};
+                    }
+
+                    static value_type one() {
+                        return {fp2::one(), fp2::zero(), fp2::zero()};
+                    }
+
+                    static value_type add(const value_type &a, const value_type &b) {
+                        return {fp2::add(a.c0, b.c0), fp2::add(a.c1, b.c1), fp2::add(a.c2, b.c2)};
+                    }
+
+                    static value_type sub(const value_type &a, const value_type &b) {
+                        return {fp2::sub(a.c0, b.c0), fp2::sub(a.c1, b.c1), fp2::sub(a.c2, b.c2)};
+                    }
+
+                    static value_type neg(const value_type &a) {
+                        return {fp2::neg(a.c0), fp2::neg(a.c1), fp2::neg(a.c2)};
+                    }
+
+                    /// Karatsuba over the three coefficients: six Fp2 products instead of nine.
+                    static wide_type mul_wide(const value_type &a, const value_type &b) {
+                        fp2_wide_type aa = fp2::mul_wide(a.c0, b.c0);
+                        fp2_wide_type bb = fp2::mul_wide(a.c1, b.c1);
+                        fp2_wide_type cc = fp2::mul_wide(a.c2, b.c2);
+
+                        fp2_wide_type t1 = fp2::mul_wide(fp2::add(a.c1, a.c2), fp2::add(b.c1, b.c2));
+                        t1 = fp2::add_wide(fp2::mul_by_nonresidue_wide(fp2::sub_wide(fp2::sub_wide(t1, bb), cc)), aa);
+                        fp2_wide_type t2 = fp2::mul_wide(fp2::add(a.c0, a.c1), fp2::add(b.c0, b.c1));
+                        t2 = fp2::add_wide(fp2::sub_wide(fp2::sub_wide(t2, aa), bb), fp2::mul_by_nonresidue_wide(cc));
+                        fp2_wide_type t3 = fp2::mul_wide(fp2::add(a.c0, a.c2), fp2::add(b.c0, b.c2));
+                        t3 = fp2::add_wide(fp2::sub_wide(fp2::sub_wide(t3, aa), cc), bb);
+                        return {t1, t2, t3};
+                    }
+
+                    /// Chung-Hasan SQR2: two products and three squarings.
+                    static wide_type sqr_wide(const value_type &a) {
+                        fp2_wide_type s0 = fp2::sqr_wide(a.c0);
+                        fp2_wide_type ab = fp2::mul_wide(a.c0, a.c1);
+                        fp2_wide_type s1 = fp2::add_wide(ab, ab);
+                        fp2_wide_type s2 = fp2::sqr_wide(fp2::add(fp2::sub(a.c0, a.c1), a.c2));
+                        fp2_wide_type bc = fp2::mul_wide(a.c1, a.c2);
+                        fp2_wide_type s3 = fp2::add_wide(bc, bc);
+                        fp2_wide_type s4 = fp2::sqr_wide(a.c2);
+                        return {fp2::add_wide(fp2::mul_by_nonresidue_wide(s3), s0),
+                                fp2::add_wide(fp2::mul_by_nonresidue_wide(s4), s1),
+                                fp2::sub_wide(fp2::sub_wide(fp2::add_wide(fp2::add_wide(s1, s2), s3), s0), s4)};
+                    }
+
+                    /// Product with c1 v.
+                    static wide_type mul_by_1_wide(const value_type &a, const fp2_type &c1) {
+                        return {fp2::mul_by_nonresidue_wide(fp2::mul_wide(a.c2, c1)), fp2::mul_wide(a.c0, c1),
+                                fp2::mul_wide(a.c1, c1)};
+                    }
+
+                    /// Product with c0 + c1 v.
+                    static wide_type mul_by_01_wide(const value_type &a, const fp2_type &c0, const fp2_type &c1) {
+                        fp2_wide_type aa = fp2::mul_wide(a.c0, c0);
+                        fp2_wide_type bb = fp2::mul_wide(a.c1, c1);
+                        fp2_wide_type t1 = fp2::add_wide(fp2::mul_by_nonresidue_wide(fp2::mul_wide(a.c2, c1)), aa);
+                        fp2_wide_type t2 = fp2::mul_wide(fp2::add(c0, c1), fp2::add(a.c0, a.c1));
+                        t2 = fp2::sub_wide(fp2::sub_wide(t2, aa), bb);
+                        fp2_wide_type t3 = fp2::add_wide(fp2::mul_wide(a.c2, c0), bb);
+                        return {t1, t2, t3};
+                    }
+
+                    static wide_type add_wide(const wide_type &a, const wide_type &b) {
+                        return {fp2::add_wide(a.c0, b.c0), fp2::add_wide(a.c1, b.c1), fp2::add_wide(a.c2, b.c2)};
+                    }
+
+                    static wide_type sub_wide(const wide_type &a, const wide_type &b) {
+                        return {fp2::sub_wide(a.c0, b.c0), fp2::sub_wide(a.c1, b.c1), fp2::sub_wide(a.c2, b.c2)};
+                    }
+
+                    static wide_type mul_by_nonresidue_wide(const wide_type &a) {
+                        return {fp2::mul_by_nonresidue_wide(a.c2), a.c0, a.c1};
+                    }
+
+                    static value_type reduce(const wide_type &a) {
+                        return {fp2::reduce(a.c0), fp2::reduce(a.c1), fp2::reduce(a.c2)};
+                    }
+
+                    static value_type mul(const value_type &a, const value_type &b) {
+                        return reduce(mul_wide(a, b));
+                    }
+
+                    static value_type sqr(const value_type &a) {
+                        return reduce(sqr_wide(a));
+                    }
+
+                    /// v (c0 + c1 v + c2 v^2) = (u + 1) c2 + c0 v + c1 v^2
+                    static value_type mul_by_nonresidue(const value_type &a) {
+                        return {fp2::mul_by_nonresidue(a.c2), a.c0, a.c1};
+                    }
+
+                    /// x -> x^p: conjugates the coefficients and scales them by (u + 1)^(k (p - 1) / 3).
+                    static value_type frobenius(const value_type &a) {
+                        // Montgomery forms; the first is purely imaginary, the second real.
+                        static constexpr fp2_381 gamma1 = {
+                            {{0, 0, 0, 0, 0, 0}},
+                            {{0xcd03c9e48671f071, 0x5dab22461fcda5d2, 0x587042afd3851b95, 0x8eb60ebe01bacb9e,
+                              0x03f97d6e83d050d2, 0x18f0206554638741}}};
+                        static constexpr fp2_381 gamma2 = {
+                            {{0x890dc9e4867545c3, 0x2af322533285a5d5, 0x50880866309b7e2c, 0xa20d1b8c7e881024,
+                              0x14e4f04fe2db9068, 0x14e56d3f1564853a}},
+                            {{0, 0, 0, 0, 0, 0}}};
+                        return {fp2::conjugate(a.c0),
+                                detail::mul_by_constant<fp2>(fp2::conjugate(a.c1), gamma1),
+                                detail::mul_by_constant<fp2>(fp2::conjugate(a.c2), gamma2)};
+                    }
+
+                    static value_type inverse(const value_type &a) {
+                        fp2_type c0 = fp2::sub(fp2::sqr(a.c0), fp2::mul_by_nonresidue(fp2::mul(a.c1, a.c2)));
+                        fp2_type c1 = fp2::sub(fp2::mul_by_nonresidue(fp2::sqr(a.c2)), fp2::mul(a.c0, a.c1));
+                        fp2_type c2 = fp2::sub(fp2::sqr(a.c1), fp2::mul(a.c0, a.c2));
+                        fp2_type t = fp2::add(fp2::mul(a.c0, c0),
+                                              fp2::mul_by_nonresidue(fp2::add(fp2::mul(a.c2, c1), fp2::mul(a.c1, c2))));
+                        // 1 / (t0 + t1 u) = (t0 - t1 u) / (t0^2 + t1^2)
+                        typename FieldOps::value_type norm = FieldOps::add(FieldOps::sqr(t.c0), FieldOps::sqr(t.c1));
+                        typename FieldOps::value_type norm_inverse = FieldOps::inverse(norm);
+                        fp2_type t_inverse = {FieldOps::mul(t.c0, norm_inverse),
+                                              FieldOps::sub(FieldOps::zero(), FieldOps::mul(t.c1, norm_inverse))};
+                        return {fp2::mul(c0, t_inverse), fp2::mul(c1, t_inverse), fp2::mul(c2, t_inverse)};
+                    }
+                };
+
+                template<typename FieldOps>
+                struct fp12_ops {
+                    using fp2 = fp2_tower_ops<FieldOps>;
+                    using fp2_type = typename fp2::value_type;
+                    using fp6 = fp6_ops<FieldOps>;
+                    using fp6_type = typename fp6::value_type;
+                    using fp6_wide_type = typename fp6::wide_type;
+
+                    struct value_type {
+                        fp6_type c0;
+                        fp6_type c1;
+                    };
+
+                    static value_type one() {
+                        return {fp6::one(), fp6::zero()};
+                    }
+
+                    static value_type mul(const value_type &a, const value_type &b) {
+                        fp6_wide_type aa = fp6::mul_wide(a.c0, b.c0);
+                        fp6_wide_type bb = fp6::mul_wide(a.c1, b.c1);
+                        fp6_wide_type c1 = fp6::mul_wide(fp6::add(a.c0, a.c1), fp6::add(b.c0, b.c1));
+                        c1 = fp6::sub_wide(fp6::sub_wide(c1, aa), bb);
+                        return {fp6::reduce(fp6::add_wide(aa, fp6::mul_by_nonresidue_wide(bb))), fp6::reduce(c1)};
+                    }
+
+                    /// Complex squaring: two Fp6 products.
+                    static value_type sqr(const value_type &a) {
+                        fp6_wide_type ab = fp6::mul_wide(a.c0, a.c1);
+                        fp6_wide_type c0 =
+                            fp6::mul_wide(fp6::add(a.c0, a.c1), fp6::add(a.c0, fp6::mul_by_nonresidue(a.c1)));
+                        c0 = fp6::sub_wide(fp6::sub_wide(c0, ab), fp6::mul_by_nonresidue_wide(ab));
+                        return {fp6::reduce(c0), fp6::reduce(fp6::add_wide(ab, ab))};
+                    }
+
+                    /**
+                     * Squaring in the cyclotomic subgroup, where the norm to Fp6 is one (Granger and Scott 2010):
+                     * three squarings in Fp4 = Fp2[w^3], six Fp2 squarings in all. Only valid after the easy part
+                     * of the final exponentiation.
+                     */
+                    static value_type cyclotomic_sqr(const value_type &a) {
+                        // Fp4 squarings of (c0.c0, c1.c1), (c1.c0, c0.c2) and (c0.c1, c1.c2).
+                        fp2_type t0, t1, t2, t3, t4, t5;
+                        fp4_sqr(a.c0.c0, a.c1.c1, t0, t1);
+                        fp4_sqr(a.c1.c0, a.c0.c2, t2, t3);
+                        fp4_sqr(a.c0.c1, a.c1.c2, t4, t5);
+                        t5 = fp2::mul_by_nonresidue(t5);
+
+                        // 3 t - 2 a for the first coefficients, 3 t + 2 a for the second.
+                        auto minus = [](const fp2_type &t, const fp2_type &x) {
+                            fp2_type d = fp2::sub(t, x);
+                            return fp2::add(fp2::add(d, d), t);
+                        };
+                        auto plus = [](const fp2_type &t, const fp2_type &x) {
+                            fp2_type d = fp2::add(t, x);
+                            return fp2::add(fp2::add(d, d), t);
+                        };
+                        return {{minus(t0, a.c0.c0), minus(t2, a.c0.c1), minus(t4, a.c0.c2)},
+                                {plus(t5, a.c1.c0), plus(t1, a.c1.c1), plus(t3, a.c1.c2)}};
+                    }
+
+                    /**
+                     * Karabina's compressed form of a cyclotomic element (Karabina 2013, "Squaring in cyclotomic
+                     * subgroups"): with g0 .. g5 the coefficients c0.c0, c0.c1, c0.c2, c1.c0, c1.c1, c1.c2, only
+                     * g1, g2, g3 and g5 are kept, and g0 and g4 are recovered on decompression.
+                     */
+                    struct compressed_type {
+                        fp2_type g1;
+                        fp2_type g2;
+                        fp2_type g3;
+                        fp2_type g5;
+                    };
+
+                    static compressed_type compress(const value_type &a) {
+                        return {a.c0.c1, a.c0.c2, a.c1.c0, a.c1.c2};
+                    }
+
+                    /// Squaring in compressed form, four Fp2 squarings.
+                    static compressed_type compressed_sqr(const compressed_type &a) {
+                        fp2_type g1g1 = fp2::sqr(a.g1);
+                        fp2_type g5g5 = fp2::sqr(a.g5);
+                        // 2 g1 g5 and 2 g2 g3 by squaring the sums.
+                        fp2_type g1g5 = fp2::sub(fp2::sub(fp2::sqr(fp2::add(a.g1, a.g5)), g1g1), g5g5);
+                        fp2_type g2g2 = fp2::sqr(a.g2);
+                        fp2_type g3g3 = fp2::sqr(a.g3);
+                        fp2_type g2g3 = fp2::sub(fp2::sub(fp2::sqr(fp2::add(a.g2, a.g3)), g2g2), g3g3);
+
+                        auto triple_minus_double = [](const fp2_type &t, const fp2_type &x) {
+                            fp2_type d = fp2::sub(t, x);
+                            return fp2::add(fp2::add(d, d), t);
+                        };
+                        auto triple_plus_double = [](const fp2_type &t, const fp2_type &x) {
+                            fp2_type d = fp2::add(t, x);
+                            return fp2::add(fp2::add(d, d), t);
+                        };
+                        // g1' = 3 (g3^2 + xi g2^2) - 2 g1, g2' = 3 (g1^2 + xi g5^2) - 2 g2,
+                        // g3' = 3 xi 2 g1 g5 + 2 g3, g5' = 3 2 g2 g3 + 2 g5
+                        return {triple_minus_double(fp2::add(g3g3, fp2::mul_by_nonresidue(g2g2)), a.g1),
+                                triple_minus_double(fp2::add(g1g1, fp2::mul_by_nonresidue(g5g5)), a.g2),
+                                triple_plus_double(fp2::mul_by_nonresidue(g1g5), a.g3),
+                                triple_plus_double(g2g3, a.g5)};
+                    }
+
+                    /**
+                     * Recovers count compressed elements with a single inversion shared by all of them. Fails,
+                     * leaving out unspecified, when one of them has a zero denominator, which only degenerate
+                     * elements such as one have.
+                     */
+                    static bool decompress(const compressed_type *a, value_type *out, std::size_t count) {
+                        std::vector<fp2_type> numerators(count), denominators(count), prefix(count);
+                        for (std::size_t i = 0; i < count; ++i) {
+                            if (fp2_is_zero(a[i].g3)) {
+                                // g4 = 2 g1 g5 / g2
+                                fp2_type g1g5 = fp2::mul(a[i].g1, a[i].g5);
+                                numerators[i] = fp2::add(g1g5, g1g5);
+                                denominators[i] = a[i].g2;
+                            } else {
+                                // g4 = (xi g5^2 + 3 g1^2 - 2 g2) / 4 g3
+                                fp2_type g1g1 = fp2::sqr(a[i].g1);
+                                fp2_type d = fp2::sub(g1g1, a[i].g2);
+                                numerators[i] = fp2::add(fp2::add(fp2::add(d, d), g1g1),
+                                                         fp2::mul_by_nonresidue(fp2::sqr(a[i].g5)));
+                                fp2_type g3 = fp2::add(a[i].g3, a[i].g3);
+                                denominators[i] = fp2::add(g3, g3);
+                            }
+                            if (fp2_is_zero(denominators[i])) {
+                                return false;
+                            }
+                            prefix[i] = i == 0 ? denominators[i] : fp2::mul(prefix[i - 1], denominators[i]);
+                        }
+
+                        fp2_type inverse = count == 0 ? fp2::one() : fp2_inverse(prefix[count - 1]);
+                        for (std::size_t i = count; i-- > 0;) {
+                            fp2_type g4 = fp2::mul(numerators[i], i == 0 ? inverse : fp2::mul(inverse, prefix[i - 1]));
+                            inverse = fp2::mul(inverse, denominators[i]);
+
+                            // g0 = xi (2 g4^2 + g3 g5 - 3 g1 g2) + 1
+                            fp2_type g1g2 = fp2::mul(a[i].g1, a[i].g2);
+                            fp2_type t = fp2::sub(fp2::sqr(g4), g1g2);
+                            t = fp2::sub(fp2::add(t, t), g1g2);
+                            t = fp2::add(t, fp2::mul(a[i].g3, a[i].g5));
+                            fp2_type g0 = fp2::add(fp2::mul_by_nonresidue(t), fp2::one());
+                            out[i] = {{g0, a[i].g1, a[i].g2}, {a[i].g3, g4, a[i].g5}};
+                        }
+                        return true;
+                    }
+
+                    /// x^(p^6), which is the inverse on the cyclotomic subgroup.
+                    static value_type conjugate(const value_type &a) {
+                        return {a.c0, fp6::neg(a.c1)};
+                    }
+
+                    /// Product with the sparse line value c0 + c1 v + c4 v w.
+                    static value_type mul_by_014(const value_type &a, const fp2_type &c0, const fp2_type &c1,
+                                                 const fp2_type &c4) {
+                        fp6_wide_type aa = fp6::mul_by_01_wide(a.c0, c0, c1);
+                        fp6_wide_type bb = fp6::mul_by_1_wide(a.c1, c4);
+                        fp6_wide_type t = fp6::mul_by_01_wide(fp6::add(a.c1, a.c0), c0, fp2::add(c1, c4));
+                        return {fp6::reduce(fp6::add_wide(fp6::mul_by_nonresidue_wide(bb), aa)),
+                                fp6::reduce(fp6::sub_wide(fp6::sub_wide(t, aa), bb))};
+                    }
+
+                    /// x -> x^p; the w coefficient is further scaled by (u + 1)^((p - 1) / 6).
+                    static value_type frobenius(const value_type &a) {
+                        static constexpr fp2_381 gamma = {
+                            {{0x07089552b319d465, 0xc6695f92b50a8313, 0x97e83cccd117228f, 0xa35baecab2dc29ee,
+                              0x1ce393ea5daace4d, 0x08f2220fb0fb66eb}},
+                            {{0xb2f66aad4ce5d646, 0x5842a06bfc497cec, 0xcf4895d42599d394, 0xc11b9cba40a8e8d0,
+                              0x2e3813cbe5a0de89, 0x110eefda88847faf}}};
+                        fp6_type c1 = fp6::frobenius(a.c1);
+                        return {fp6::frobenius(a.c0),
+                                {detail::mul_by_constant<fp2>(c1.c0, gamma),
+                                 detail::mul_by_constant<fp2>(c1.c1, gamma),
+                                 detail::mul_by_constant<fp2>(c1.c2, gamma)}};
+                    }
+
+                    static value_type inverse(const value_type &a) {
+                        fp6_type t = fp6::inverse(fp6::sub(fp6::sqr(a.c0), fp6::mul_by_nonresidue(fp6::sqr(a.c1))));
+                        return {fp6::mul(a.c0, t), fp6::neg(fp6::mul(a.c1, t))};
+                    }
+
+                    static value_type load(const fp12_381 &a) {
+                        return {load(a.c0), load(a.c1)};
+                    }
+
+                    static fp12_381 store(const value_type &a) {
+                        return {store(a.c0), store(a.c1)};
+                    }
+
+                private:
+                    /// (a + b s)^2 in Fp4 = Fp2[s] / (s^2 - (u + 1)): a^2 + (u + 1) b^2 and 2 a b.
+                    static void fp4_sqr(const fp2_type &a, const fp2_type &b, fp2_type &c0, fp2_type &c1) {
+                        fp2_type aa = fp2::sqr(a);
+                        fp2_type bb = fp2::sqr(b);
+                        c0 = fp2::add(aa, fp2::mul_by_nonresidue(bb));
+                        c1 = fp2::sub(fp2::sub(fp2::sqr(fp2::add(a, b)), aa), bb);
+                    }
+
+                    static bool fp2_is_zero(const fp2_type &a) {
+                        return FieldOps::is_zero(a.c0) && FieldOps::is_zero(a.c1);
+                    }
+
+                    /// 1 / (a0 + a1 u) = (a0 - a1 u) / (a0^2 + a1^2)
+                    static fp2_type fp2_inverse(const fp2_type &a) {
+                        typename FieldOps::value_type norm_inverse =
+                            FieldOps::inverse(FieldOps::add(FieldOps::sqr(a.c0), FieldOps::sqr(a.c1)));
+                        return {FieldOps::mul(a.c0, norm_inverse),
+                                FieldOps::sub(FieldOps::zero(), FieldOps::mul(a.c1, norm_inverse))};
+                    }
+
+                    static fp6_type load(const fp6_381 &a) {
+                        return {load(a.c0), load(a.c1), load(a.c2)};
+                    }
+
+                    static fp2_type load(const fp2_381 &a) {
+                        return fp2::load([&](std::size_t) -> const fp2_381 & { return a; });
+                    }
+
+                    static fp6_381 store(const fp6_type &a) {
+                        return {store(a.c0), store(a.c1), store(a.c2)};
+                    }
+
+                    static fp2_381 store(const fp2_type &a) {
+                        fp2_381 r;
+                        fp2::store(a, [&](std::size_t) -> fp2_381 & { return r; });
+                        return r;
+                    }
+                };
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_ARITHMETIC_TOWER_HPP
@@ -0,0 +1,271 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_CONTAINER_HPP
+#define CRYPTO3_CLI_CONTAINER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <nil/crypto3/algebra/curves/bls12.hpp>
+
+#include <nil/crypto3/cli/huge_pages.hpp>
+#include <nil/crypto3/cli/point_records.hpp>
+#include <nil/crypto3/cli/scheduler.hpp>
+#include <nil/crypto3/cli/sections.hpp>
+#include <nil/crypto3/cli/validation_cache.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+
+            /**
+             * Container format, version 1. All integers are little-endian.
+             *
+             *   0   magic "NILPTAU\0"
+             *   8   u32 version
+             *   12  u32 curve id
+             *   16  u32 point encoding
+             *   20  u32 number of sections
+             *   24  u64 tau powers
+             *   32  per section: u64 offset, u64 element count, u64 element size
+             *   176 u64 fingerprint of the build that wrote native points, zero for other encodings
+             *
+             * The header fills the first page; sections follow in the order of cli::section, each starting on a
+             * section_alignment boundary.
+             */
+            constexpr std::array<std::uint8_t, 8> container_magic = {'N', 'I', 'L', 'P', 'T', 'A', 'U', '\0'};
+            constexpr std::uint32_t container_version = 1;
+
+            template<typename CurveType>
+            struct curve_id;
+
+            template<>
+            struct curve_id<algebra::curves::bls12<381>> {
+                constexpr static const std::uint32_t value = 1;
+            };
+
+            struct container_header {
+                std::uint32_t version;
+                std::uint32_t curve;
+                accumulator_layout layout;
+            };
+
+            namespace detail {
+                constexpr std::size_t fingerprint_offset = 32 + 24 * sections_count;
+
+                template<typename T>
+                void store_le(std::uint8_t *out, T value) {
+                    for (std::size_t i = 0; i < sizeof(T); ++i) {
+                        out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+                    }
+                }
+
+                template<typename T>
+                T load_le(const std::uint8_t *in) {
+                    T value = 0;
+                    for (std::size_t i = sizeof(T); i > 0; --i) {
+                        value = (value << 8) | in[i - 1];
+                    }
+                    return value;
+                }
+            }    // namespace detail
+
+            inline std::vector<std::uint8_t> encode_container_header(const container_header &header) {
+                std::vector<std::uint8_t> page(section_alignment, 0);
+                std::copy(container_magic.begin(), container_magic.end(), page.begin());
+                detail::store_le<std::uint32_t>(&page[8], header.version);
+                detail::store_le<std::uint32_t>(&page[12], header.curve);
+                detail::store_le<std::uint32_t>(&page[16], static_cast<std::uint32_t>(header.layout.format.encoding));
+                detail::store_le<std::uint32_t>(&page[20], sections_count);
+                detail::store_le<std::uint64_t>(&page[24], header.layout.tau_powers);
+                for (std::size_t i = 0; i < sections_count; ++i) {
+                    std::uint8_t *entry = &page[32 + 24 * i];
+                    detail::store_le<std::uint64_t>(entry, header.layout.sections[i].offset);
+                    detail::store_le<std::uint64_t>(entry + 8, header.layout.sections[i].count);
+                    detail::store_le<std::uint64_t>(entry + 16, header.layout.sections[i].element_size);
+                }
+                detail::store_le<std::uint64_t>(&page[detail::fingerprint_offset], header.layout.format.fingerprint);
+                return page;
+            }
+
+            inline bool is_container(const std::uint8_t *first, std::size_t length) {
+                return length >= container_magic.size() &&
+                       std::equal(container_magic.begin(), container_magic.end(), first);
+            }
+
+            /**
+             * Parses a header page. file_size bounds every section, the section counts must be those of
+             * tau_powers powers and no two sections may overlap, so a corrupt or crafted header can't send
+             * readers astray. Record sizes are left to the reader, which knows the point encodings.
+             */
+            inline container_header decode_container_header(const std::uint8_t *page, std::size_t file_size) {
+                if (!is_container(page, section_alignment)) {
+                    throw std::invalid_argument("invalid format");
+                }
+                container_header header;
+                header.version = detail::load_le<std::uint32_t>(&page[8]);
+                if (header.version != container_version) {
+                    throw std::invalid_argument("unsupported container version " + std::to_string(header.version));
+                }
+                header.curve = detail::load_le<std::uint32_t>(&page[12]);
+                header.layout.format.encoding =
+                    static_cast<point_encoding>(detail::load_le<std::uint32_t>(&page[16]));
+                header.layout.format.fingerprint = detail::load_le<std::uint64_t>(&page[detail::fingerprint_offset]);
+                if (detail::load_le<std::uint32_t>(&page[20]) != sections_count) {
+                    throw std::invalid_argument("invalid format");
+                }
+                header.layout.tau_powers = detail::load_le<std::uint64_t>(&page[24]);
+                header.layout.length = section_alignment;
+                for (std::size_t i = 0; i < sections_count; ++i) {
+                    const std::uint8_t *entry = &page[32 + 24 * i];
+                    section_extent &extent = header.layout.sections[i];
+                    extent.offset = detail::load_le<std::uint64_t>(entry);
+                    extent.count = detail::load_le<std::uint64_t>(entry + 8);
+                    extent.element_size = detail::load_le<std::uint64_t>(entry + 16);
+                    bool fits = extent.offset >= section_alignment && extent.offset <= file_size &&
+                                (extent.element_size == 0 ||
+                                 extent.count <= (file_size - extent.offset) / extent.element_size);
+                    if (!fits) {
+                        throw std::invalid_argument("invalid format");
+                    }
+                    header.layout.length = std::max(header.layout.length, extent.offset + extent.length());
+                }
+
+                // Every section holds at least a byte per power, which keeps 2 N - 1 from overflowing.
+                std::size_t n = header.layout.tau_powers;
+                if (n < 2 || n > file_size) {
+                    throw std::invalid_argument("invalid format");
+                }
+                const std::size_t expected_counts[accumulator_sections_count] = {2 * n - 1, n, n, n, 1};
+                for (std::size_t i = 0; i < accumulator_sections_count; ++i) {
+                    const section_extent &extent = header.layout.sections[i];
+                    if (extent.count != expected_counts[i] || extent.element_size == 0) {
+                        throw std::invalid_argument("invalid format");
+                    }
+                }
+                if (header.layout[section::public_key].count > 1) {
+                    throw std::invalid_argument("invalid format");
+                }
+
+                // An empty public key occupies nothing and may sit anywhere.
+                std::vector<const section_extent *> by_offset;
+                for (const section_extent &extent : header.layout.sections) {
+                    if (extent.length() != 0) {
+                        by_offset.push_back(&extent);
+                    }
+                }
+                std::sort(by_offset.begin(), by_offset.end(),
+                          [](const section_extent *a, const section_extent *b) { return a->offset < b->offset; });
+                for (std::size_t i = 1; i < by_offset.size(); ++i) {
+                    if (by_offset[i - 1]->offset + by_offset[i - 1]->length() > by_offset[i]->offset) {
+                        throw std::invalid_argument("invalid format");
+                    }
+                }
+                return header;
+            }
+
+            /**
+             * Writes an accumulator, and the public key for responses, in the container format with points in
+             * the given encoding; native points are tagged with this build's fingerprint. Points are encoded in
+             * parallel a chunk at a time and every chunk is written at its final offset. The public key blob is
+             * written as it is. Given validated, the points are known to have passed the full checks and the
+             * digests of the records written for them are listed.
+             */
+            template<typename MarshallingPolicy, typename CurveType, typename Accumulator>
+            void write_container(scheduler &s,
+                                 const std::string &path,
+                                 const Accumulator &acc,
+                                 const std::vector<std::uint8_t> &public_key_blob,
+                                 point_encoding encoding = point_encoding::compressed,
+                                 validation_cache *validated = nullptr) {
+                using g1_type = typename CurveType::template g1_type<>;
+                using g2_type = typename CurveType::template g2_type<>;
+                using g1_records = point_records<MarshallingPolicy, g1_type>;
+                using g2_records = point_records<MarshallingPolicy, g2_type>;
+
+                point_format format {encoding,
+                                     encoding == point_encoding::native ? arithmetic::native_fingerprint() : 0};
+                if (!g1_records::supports(format) || !g2_records::supports(format)) {
+                    throw std::invalid_argument("unsupported point encoding");
+                }
+                container_header header {
+                    container_version, curve_id<CurveType>::value,
+                    accumulator_layout::container(acc.tau_powers_g2.size(), g1_records::size(format),
+                                                  g2_records::size(format), public_key_blob.size())};
+                header.layout.format = format;
+
+                std::ofstream out(path, std::ios_base::binary);
+                std::vector<std::uint8_t> page = encode_container_header(header);
+                out.write(reinterpret_cast<const char *>(page.data()), page.size());
+
+                auto write_section = [&](section sec, const auto &points) {
+                    using group_type = typename std::conditional<
+                        std::is_same<typename std::decay<decltype(points[0])>::type,
+                                     typename g2_type::value_type>::value,
+                        g2_type, g1_type>::type;
+                    constexpr std::size_t chunk_elements = 1 << 16;
+
+                    const section_extent &extent = header.layout[sec];
+                    std::vector<std::uint8_t, huge_page_allocator<std::uint8_t>> blob;
+                    for (std::size_t first = 0; first < extent.count; first += chunk_elements) {
+                        std::size_t count = std::min(chunk_elements, extent.count - first);
+                        blob.resize(count * extent.element_size);
+                        parallel_for(s, 0, count,
+                                     std::is_same<group_type, g2_type>::value ? task_cost::g2 : task_cost::g1,
+                                     [&](std::size_t begin, std::size_t end) {
+                                         point_records<MarshallingPolicy, group_type>::encode(
+                                             format, &points[first + begin], end - begin,
+                                             blob.data() + begin * extent.element_size);
+                                     });
+                        if (validated != nullptr) {
+                            for_each_validation_chunk(
+                                s, extent.count, first, count,
+                                [&](std::size_t part_first, std::size_t part_count, bool) {
+                                    validated->insert(records_digest(
+                                        format, extent.element_size,
+                                        blob.data() + (part_first - first) * extent.element_size, part_count));
+                                });
+                        }
+                        out.seekp(extent.offset + first * extent.element_size);
+                        out.write(reinterpret_cast<const char *>(blob.data()), blob.size());
+                    }
+                };
+
+                write_section(section::tau_g1, acc.tau_powers_g1);
+                write_section(section::tau_g2, acc.tau_powers_g2);
+                write_section(section::alpha_tau_g1, acc.alpha_tau_powers_g1);
+                write_section(section::beta_tau_g1, acc.beta_tau_powers_g1);
+                write_section(section::beta_g2, std::array<typename g2_type::value_type, 1> {acc.beta_g2});
+                if (!public_key_blob.empty()) {
+                    out.seekp(header.layout[section::public_key].offset);
+                    out.write(reinterpret_cast<const char *>(public_key_blob.data()), public_key_blob.size());
+                }
+
+                // Pad the last section to a whole page so every section can be read with aligned transfers.
+                const section_extent &last =
+                    header.layout[public_key_blob.empty() ? section::beta_g2 : section::public_key];
+                std::size_t end = last.offset + last.length();
+                std::vector<std::uint8_t> padding(header.layout.length - end, 0);
+                out.seekp(end);
+                out.write(reinterpret_cast<const char *>(padding.data()), padding.size());
+
+                if (!out) {
+                    throw std::runtime_error("failed to write " + path);
+                }
+            }
+        }    // namespace cli
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_CONTAINER_HPP
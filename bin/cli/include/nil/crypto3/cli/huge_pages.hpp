@@ -0,0 +1,159 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_HUGE_PAGES_HPP
+#define CRYPTO3_CLI_HUGE_PAGES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <new>
+#include <string>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace detail {
+
+                constexpr std::size_t huge_page_size = std::size_t(2) << 20;
+                constexpr std::size_t small_block_alignment = 64;
+
+                /// Number of NUMA nodes the kernel reports online, 1 where it reports none.
+                inline std::size_t numa_nodes() {
+                    static const std::size_t nodes = []() -> std::size_t {
+                        // A list of ranges such as "0" or "0-3"; the highest node ends it.
+                        std::ifstream online("/sys/devices/system/node/online");
+                        std::string list;
+                        if (!(online >> list)) {
+                            return 1;
+                        }
+                        std::size_t last = list.find_last_of(",-");
+                        try {
+                            return std::stoul(last == std::string::npos ? list : list.substr(last + 1)) + 1;
+                        } catch (const std::exception &) {
+                            return 1;
+                        }
+                    }();
+                    return nodes;
+                }
+
+                inline std::size_t huge_page_length(std::size_t bytes) {
+                    return (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+                }
+
+#ifdef __linux__
+                /// Spreads the pages of [p, p + length) round-robin over every node. Must precede the first touch.
+                inline void interleave(void *p, std::size_t length) {
+                    constexpr int mpol_interleave = 3;
+                    unsigned long mask = 0;
+                    std::size_t nodes = numa_nodes();
+                    for (std::size_t node = 0; node < nodes && node < 8 * sizeof(mask); ++node) {
+                        mask |= 1UL << node;
+                    }
+                    // Best effort: without the permission or the policy, pages stay where first touched.
+                    ::syscall(SYS_mbind, p, length, mpol_interleave, &mask, 8 * sizeof(mask), 0);
+                }
+
+                /**
+                 * Anonymous memory in 2 MiB pages: from the reserved pool when there is one, otherwise as a
+                 * transparent huge page region aligned so the kernel can back all of it with whole pages.
+                 */
+                inline void *map_huge_pages(std::size_t bytes) {
+                    std::size_t length = huge_page_length(bytes);
+                    void *p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                                     -1, 0);
+                    if (p == MAP_FAILED) {
+                        void *region = ::mmap(nullptr, length + huge_page_size, PROT_READ | PROT_WRITE,
+                                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                        if (region == MAP_FAILED) {
+                            throw std::bad_alloc();
+                        }
+                        auto first = reinterpret_cast<std::uintptr_t>(region);
+                        auto aligned = (first + huge_page_size - 1) / huge_page_size * huge_page_size;
+                        if (aligned != first) {
+                            ::munmap(region, aligned - first);
+                        }
+                        ::munmap(reinterpret_cast<void *>(aligned + length), first + huge_page_size - aligned);
+                        p = reinterpret_cast<void *>(aligned);
+                        ::madvise(p, length, MADV_HUGEPAGE);
+                    }
+                    if (numa_nodes() > 1) {
+                        interleave(p, length);
+                    }
+                    return p;
+                }
+
+                inline void unmap_huge_pages(void *p, std::size_t bytes) {
+                    ::munmap(p, huge_page_length(bytes));
+                }
+#endif
+            }    // namespace detail
+
+            /**
+             * Allocator for the buffers that span the whole of a power vector. Blocks of a huge page or more are
+             * mapped in 2 MiB pages, so a pass over them takes one TLB entry per 2 MiB instead of one per 4 KiB,
+             * and are interleaved across NUMA nodes: the scheduler steals work, so which thread touches a range
+             * isn't known in advance and first-touch placement would pile the buffer onto one node. Smaller blocks
+             * come from operator new on cache-line boundaries.
+             */
+            template<typename T>
+            struct huge_page_allocator {
+                using value_type = T;
+
+                template<typename U>
+                struct rebind {
+                    using other = huge_page_allocator<U>;
+                };
+
+                huge_page_allocator() = default;
+
+                template<typename U>
+                huge_page_allocator(const huge_page_allocator<U> &) {
+                }
+
+                T *allocate(std::size_t n) {
+                    std::size_t bytes = n * sizeof(T);
+#ifdef __linux__
+                    if (bytes >= detail::huge_page_size) {
+                        return static_cast<T *>(detail::map_huge_pages(bytes));
+                    }
+#endif
+                    return static_cast<T *>(::operator new(bytes, std::align_val_t(detail::small_block_alignment)));
+                }
+
+                void deallocate(T *p, std::size_t n) {
+                    std::size_t bytes = n * sizeof(T);
+#ifdef __linux__
+                    if (bytes >= detail::huge_page_size) {
+                        detail::unmap_huge_pages(p, bytes);
+                        return;
+                    }
+#endif
+                    ::operator delete(p, std::align_val_t(detail::small_block_alignment));
+                }
+
+                template<typename U>
+                bool operator==(const huge_page_allocator<U> &) const {
+                    return true;
+                }
+
+                template<typename U>
+                bool operator!=(const huge_page_allocator<U> &) const {
+                    return false;
+                }
+            };
+        }    // namespace cli
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_HUGE_PAGES_HPP
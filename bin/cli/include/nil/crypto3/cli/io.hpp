@@ -0,0 +1,109 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_IO_HPP
+#define CRYPTO3_CLI_IO_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+
+            class file_descriptor {
+            public:
+                file_descriptor(const std::string &path, int flags, mode_t mode = 0) :
+                    fd(::open(path.c_str(), flags, mode)) {
+                    if (fd < 0) {
+                        throw std::system_error(errno, std::generic_category(), path);
+                    }
+                }
+
+                file_descriptor(const file_descriptor &) = delete;
+                file_descriptor &operator=(const file_descriptor &) = delete;
+
+                ~file_descriptor() {
+                    ::close(fd);
+                }
+
+                int get() const {
+                    return fd;
+                }
+
+            private:
+                int fd;
+            };
+
+            /**
+             * Read-only mapping of a whole file. Pages are brought in by the kernel on first access and can be
+             * dropped under memory pressure at no cost, since they are backed by the file itself.
+             */
+            class mapped_file {
+            public:
+                explicit mapped_file(const std::string &path) {
+                    file_descriptor fd(path, O_RDONLY);
+                    struct stat st;
+                    if (::fstat(fd.get(), &st) != 0) {
+                        throw std::system_error(errno, std::generic_category(), path);
+                    }
+                    length = static_cast<std::size_t>(st.st_size);
+                    if (length == 0) {
+                        return;
+                    }
+                    void *p = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd.get(), 0);
+                    if (p == MAP_FAILED) {
+                        throw std::system_error(errno, std::generic_category(), path);
+                    }
+                    bytes = static_cast<const std::uint8_t *>(p);
+                }
+
+                mapped_file(const mapped_file &) = delete;
+                mapped_file &operator=(const mapped_file &) = delete;
+
+                ~mapped_file() {
+                    if (bytes != nullptr) {
+                        ::munmap(const_cast<std::uint8_t *>(bytes), length);
+                    }
+                }
+
+                const std::uint8_t *data() const {
+                    return bytes;
+                }
+
+                std::size_t size() const {
+                    return length;
+                }
+
+                /// Hints that [offset, offset + count) will be read front to back.
+                void advise_sequential(std::size_t offset, std::size_t count) const {
+                    std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+                    std::size_t first = offset / page * page;
+                    if (bytes != nullptr && first < length) {
+                        ::madvise(const_cast<std::uint8_t *>(bytes) + first,
+                                  std::min(offset + count, length) - first, MADV_SEQUENTIAL);
+                    }
+                }
+
+            private:
+                const std::uint8_t *bytes = nullptr;
+                std::size_t length = 0;
+            };
+        }    // namespace cli
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_IO_HPP
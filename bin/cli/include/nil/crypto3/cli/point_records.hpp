@@ -0,0 +1,171 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_POINT_RECORDS_HPP
+#define CRYPTO3_CLI_POINT_RECORDS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <nil/crypto3/cli/arena.hpp>
+#include <nil/crypto3/cli/arithmetic/compact_points.hpp>
+#include <nil/crypto3/cli/arithmetic/native.hpp>
+#include <nil/crypto3/cli/sections.hpp>
+#include <nil/crypto3/cli/validation_cache.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+
+            /**
+             * What loading a point checks of it. full is for anything not known to have passed validation;
+             * on_curve drops the subgroup check, for records whose bytes this host checked in full before.
+             */
+            enum class point_checks { full, on_curve };
+
+            /// Thrown for a record which doesn't hold a valid point, naming the section and the power it holds.
+            class bad_point : public std::invalid_argument {
+            public:
+                bad_point(section where, std::size_t index, const std::string &reason) :
+                    std::invalid_argument(reason), where(where), index(index) {
+                }
+
+                section where;
+                std::size_t index;
+            };
+
+            /**
+             * The fixed-size records a section holds its points in, whichever point_format the file is in:
+             * compressed through the marshalling policy, or native, where a build reading its own records
+             * copies them into compact storage as they are.
+             */
+            template<typename MarshallingPolicy, typename GroupType>
+            struct point_records {
+                using value_type = typename GroupType::value_type;
+                using compact_type = arithmetic::compact_points<value_type>;
+                using storage_type = typename compact_type::storage_type;
+                using native_type = arithmetic::native_points<value_type>;
+
+                /// Whether this build reads and writes points in format.
+                static bool supports(const point_format &format) {
+                    if constexpr (native_type::available) {
+                        if (format.is_native()) {
+                            return arithmetic::native_readable(format.fingerprint);
+                        }
+                    }
+                    return format.encoding == point_encoding::compressed;
+                }
+
+                static std::size_t size(const point_format &format) {
+                    if constexpr (native_type::available) {
+                        if (format.is_native()) {
+                            return native_type::size;
+                        }
+                    }
+                    return MarshallingPolicy::template element_size<GroupType>();
+                }
+
+                static void encode(const point_format &format, const value_type *points, std::size_t count,
+                                   std::uint8_t *out) {
+                    if constexpr (native_type::available) {
+                        if (format.is_native()) {
+                            scratch_scope scratch;
+                            scratch_vector<storage_type> compact(count, scratch.resource());
+                            compact_type::compress(points, compact.data(), count);
+                            native_type::store(compact.data(), count, out);
+                            return;
+                        }
+                    }
+                    MarshallingPolicy::template serialize_elements<GroupType>(points, count, out);
+                }
+
+                /// Decodes count records into points and, unless compact is null, into their compact form, which
+                /// native records are in already.
+                static void decode(const point_format &format, const std::uint8_t *in, std::size_t count,
+                                   value_type *points, storage_type *compact = nullptr) {
+                    if constexpr (native_type::available) {
+                        static_assert(std::is_same<typename native_type::storage_type, storage_type>::value,
+                                      "native records load into compact storage");
+                        if (format.is_native()) {
+                            scratch_scope scratch;
+                            scratch_vector<storage_type> loaded(compact == nullptr ? count : 0, scratch.resource());
+                            storage_type *affine = compact == nullptr ? loaded.data() : compact;
+                            if (!native_type::load(in, count, affine,
+                                                   format.fingerprint == arithmetic::native_fingerprint())) {
+                                throw std::invalid_argument("invalid format");
+                            }
+                            for (std::size_t i = 0; i < count; ++i) {
+                                points[i] = compact_type::expand(affine[i]);
+                            }
+                            return;
+                        }
+                    }
+                    MarshallingPolicy::template deserialize_elements<GroupType>(in, count, points);
+                    if (compact != nullptr) {
+                        compact_type::compress(points, compact, count);
+                    }
+                }
+
+                /**
+                 * Decodes and checks the count records at in, which must be a copy of its own the caller holds,
+                 * so the bytes hashed are the bytes decoded. Given validated, records whose digest is listed are
+                 * only checked to be on the curve, and records which pass the full checks are listed.
+                 */
+                static void load(const point_format &format, const std::uint8_t *in, std::size_t count,
+                                 value_type *points, storage_type *compact, validation_cache *validated) {
+                    point_checks checks = point_checks::full;
+                    content_digest digest {};
+                    if (validated != nullptr) {
+                        digest = records_digest(format, size(format), in, count);
+                        if (validated->contains(digest)) {
+                            checks = point_checks::on_curve;
+                        }
+                    }
+                    decode(format, in, count, points, compact);
+                    check(checks, points, count);
+                    if (validated != nullptr && checks == point_checks::full) {
+                        validated->insert(digest);
+                    }
+                }
+
+                /**
+                 * Throws a bad_point for the first of the count records at in which fails to load on its own, in
+                 * being power first of where. Records are loaded one by one, so this is only for after loading
+                 * them together failed with failure, which is reported at first if they all load alone.
+                 */
+                [[noreturn]] static void find_bad_point(const point_format &format, section where, std::size_t first,
+                                                        const std::uint8_t *in, std::size_t count,
+                                                        const std::invalid_argument &failure) {
+                    const std::size_t record_size = size(format);
+                    for (std::size_t i = 0; i < count; ++i) {
+                        value_type point;
+                        try {
+                            decode(format, in + i * record_size, 1, &point);
+                            check(point_checks::full, &point, 1);
+                        } catch (const std::invalid_argument &e) {
+                            throw bad_point(where, first + i, e.what());
+                        }
+                    }
+                    throw bad_point(where, first, failure.what());
+                }
+
+                /// Throws unless every one of count decoded points passes checks.
+                static void check(point_checks checks, const value_type *points, std::size_t count) {
+                    if (checks == point_checks::on_curve) {
+                        MarshallingPolicy::template validate_curve_elements<GroupType>(points, count);
+                    } else {
+                        MarshallingPolicy::template validate_elements<GroupType>(points, count);
+                    }
+                }
+            };
+        }    // namespace cli
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_POINT_RECORDS_HPP
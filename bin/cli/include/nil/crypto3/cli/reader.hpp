@@ -0,0 +1,195 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_READER_HPP
+#define CRYPTO3_CLI_READER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <nil/crypto3/cli/container.hpp>
+#include <nil/crypto3/cli/huge_pages.hpp>
+#include <nil/crypto3/cli/point_records.hpp>
+#include <nil/crypto3/cli/scheduler.hpp>
+#include <nil/crypto3/cli/sections.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+
+            /**
+             * Random access to the sections of a serialized challenge or response, either in the container format
+             * or as a plain marshalling stream. Nothing is decoded up front: read() seeks to the requested range of
+             * powers and decodes only that range, rejecting points outside the prime-order subgroup unless validated
+             * lists the chunk of records they were read from. A point which is rejected throws a bad_point.
+             */
+            template<typename MarshallingPolicy, typename CurveType>
+            class accumulator_reader {
+            public:
+                using g1_type = typename CurveType::template g1_type<>;
+                using g2_type = typename CurveType::template g2_type<>;
+                using g1_records = point_records<MarshallingPolicy, g1_type>;
+                using g2_records = point_records<MarshallingPolicy, g2_type>;
+
+                /// has_public_key tells apart responses from challenges in plain streams; containers record it.
+                accumulator_reader(const std::string &path, bool has_public_key,
+                                   validation_cache *validated = nullptr) :
+                    in(path, std::ios_base::binary),
+                    validated(validated) {
+                    if (!in) {
+                        throw std::invalid_argument("File " + path + " doesn't exist, make sure you created it!");
+                    }
+                    std::size_t g1_size = MarshallingPolicy::template element_size<g1_type>();
+                    std::size_t g2_size = MarshallingPolicy::template element_size<g2_type>();
+                    std::size_t public_key_size = 3 * (2 * g1_size + g2_size);
+                    std::size_t length = std::filesystem::file_size(path);
+
+                    std::vector<std::uint8_t> page(std::min(length, section_alignment));
+                    in.read(reinterpret_cast<char *>(page.data()), page.size());
+                    in.clear();
+                    if (is_container(page.data(), page.size())) {
+                        if (page.size() < section_alignment) {
+                            throw std::invalid_argument("invalid format");
+                        }
+                        container_header header = decode_container_header(page.data(), length);
+                        if (header.curve != curve_id<CurveType>::value) {
+                            throw std::invalid_argument("the file belongs to a ceremony on a different curve");
+                        }
+                        const point_format &format = header.layout.format;
+                        if (format.is_native() && !arithmetic::native_readable(format.fingerprint)) {
+                            throw std::invalid_argument("the file holds native points of an incompatible build");
+                        }
+                        if (!g1_records::supports(format) || !g2_records::supports(format)) {
+                            throw std::invalid_argument("unsupported point encoding");
+                        }
+                        for (section sec : {section::tau_g1, section::alpha_tau_g1, section::beta_tau_g1}) {
+                            if (header.layout[sec].element_size != g1_records::size(format)) {
+                                throw std::invalid_argument("invalid format");
+                            }
+                        }
+                        for (section sec : {section::tau_g2, section::beta_g2}) {
+                            if (header.layout[sec].element_size != g2_records::size(format)) {
+                                throw std::invalid_argument("invalid format");
+                            }
+                        }
+                        acc_layout = header.layout;
+                    } else if (has_public_key) {
+                        if (length < public_key_size) {
+                            throw std::invalid_argument("invalid response format");
+                        }
+                        acc_layout = detect_stream_layout(length - public_key_size, g1_size, g2_size, public_key_size);
+                    } else {
+                        acc_layout = detect_stream_layout(length, g1_size, g2_size, 0);
+                    }
+                }
+
+                const accumulator_layout &layout() const {
+                    return acc_layout;
+                }
+
+                std::size_t tau_powers() const {
+                    return acc_layout.tau_powers;
+                }
+
+                template<typename GroupType>
+                std::vector<typename GroupType::value_type> read(scheduler &s, section sec, std::size_t first,
+                                                                 std::size_t count) {
+                    const section_extent &extent = acc_layout[sec];
+                    if (first + count > extent.count) {
+                        throw std::out_of_range("requested powers lie beyond the end of the section");
+                    }
+
+                    std::vector<std::uint8_t, huge_page_allocator<std::uint8_t>> blob(count * extent.element_size);
+                    in.seekg(extent.offset + first * extent.element_size);
+                    in.read(reinterpret_cast<char *>(blob.data()), blob.size());
+                    if (!in) {
+                        throw std::invalid_argument("invalid format");
+                    }
+
+                    // The blob is this reader's own, so what is hashed is what is decoded.
+                    using records_type = point_records<MarshallingPolicy, GroupType>;
+                    std::vector<typename GroupType::value_type> points(count);
+                    for_each_validation_chunk(
+                        s, extent.count, first, count, [&](std::size_t part_first, std::size_t part_count, bool whole) {
+                            const std::uint8_t *records = blob.data() + (part_first - first) * extent.element_size;
+                            try {
+                                records_type::load(acc_layout.format, records, part_count,
+                                                   points.data() + part_first - first, nullptr,
+                                                   whole ? validated : nullptr);
+                            } catch (const std::invalid_argument &e) {
+                                records_type::find_bad_point(acc_layout.format, sec, part_first, records, part_count,
+                                                             e);
+                            }
+                        });
+                    return points;
+                }
+
+                /// Encoded public key of a response, to be decoded by the marshalling policy.
+                std::vector<std::uint8_t> read_public_key() {
+                    const section_extent &extent = acc_layout[section::public_key];
+                    if (extent.count == 0) {
+                        throw std::invalid_argument("invalid response format");
+                    }
+                    std::vector<std::uint8_t> blob(extent.length());
+                    in.seekg(extent.offset);
+                    in.read(reinterpret_cast<char *>(blob.data()), blob.size());
+                    if (!in) {
+                        throw std::invalid_argument("invalid response format");
+                    }
+                    return blob;
+                }
+
+            private:
+                /**
+                 * The stream carries no header, so its layout is solved for from its length. The power count
+                 * N satisfies length = N * (4 * |G1| + |G2|) - |G1| + |G2| + 4 * prefix for the width of the
+                 * vector length prefixes, which is confirmed by reading the first of them.
+                 */
+                accumulator_layout detect_stream_layout(std::size_t length,
+                                                        std::size_t g1_size,
+                                                        std::size_t g2_size,
+                                                        std::size_t public_key_size) {
+                    for (std::size_t prefix_size : {0, 1, 2, 4, 8}) {
+                        std::size_t fixed = 4 * prefix_size + g2_size;
+                        if (length + g1_size < fixed || (length + g1_size - fixed) % (4 * g1_size + g2_size) != 0) {
+                            continue;
+                        }
+                        std::size_t tau_powers = (length + g1_size - fixed) / (4 * g1_size + g2_size);
+                        if (tau_powers < 2) {
+                            continue;
+                        }
+                        if (prefix_size != 0 && read_prefix(prefix_size) != 2 * tau_powers - 1) {
+                            continue;
+                        }
+                        return accumulator_layout::stream(tau_powers, g1_size, g2_size, prefix_size, public_key_size);
+                    }
+                    throw std::invalid_argument("invalid format");
+                }
+
+                // Length prefixes are little-endian, like everything else the marshalling policy writes.
+                std::uint64_t read_prefix(std::size_t prefix_size) {
+                    std::array<std::uint8_t, 8> bytes {};
+                    in.seekg(0);
+                    in.read(reinterpret_cast<char *>(bytes.data()), prefix_size);
+                    in.clear();
+                    return detail::load_le<std::uint64_t>(bytes.data());
+                }
+
+                std::ifstream in;
+                validation_cache *validated;
+                accumulator_layout acc_layout;
+            };
+        }    // namespace cli
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_READER_HPP
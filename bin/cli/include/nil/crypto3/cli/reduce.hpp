@@ -0,0 +1,118 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_REDUCE_HPP
+#define CRYPTO3_CLI_REDUCE_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <nil/crypto3/cli/container.hpp>
+#include <nil/crypto3/cli/io.hpp>
+#include <nil/crypto3/cli/sections.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace detail {
+
+                inline void copy_range_rw(int in, off_t in_offset, int out, off_t out_offset, std::size_t length) {
+                    std::vector<std::uint8_t> buffer(std::min<std::size_t>(length, 1 << 24));
+                    while (length > 0) {
+                        ssize_t n = ::pread(in, buffer.data(), std::min(buffer.size(), length), in_offset);
+                        if (n <= 0) {
+                            throw std::system_error(n == 0 ? EIO : errno, std::generic_category(), "read");
+                        }
+                        for (ssize_t written = 0; written < n;) {
+                            ssize_t w = ::pwrite(out, buffer.data() + written, n - written, out_offset + written);
+                            if (w < 0) {
+                                throw std::system_error(errno, std::generic_category(), "write");
+                            }
+                            written += w;
+                        }
+                        in_offset += n;
+                        out_offset += n;
+                        length -= n;
+                    }
+                }
+
+                /// Copies a byte range between files in the kernel when possible, through a buffer otherwise.
+                inline void copy_range(int in, off_t in_offset, int out, off_t out_offset, std::size_t length) {
+#if defined(__linux__)
+                    while (length > 0) {
+                        ssize_t n = ::copy_file_range(in, &in_offset, out, &out_offset, length, 0);
+                        if (n < 0 && (errno == ENOSYS || errno == EXDEV || errno == EINVAL || errno == EOPNOTSUPP)) {
+                            break;
+                        }
+                        if (n <= 0) {
+                            throw std::system_error(n == 0 ? EIO : errno, std::generic_category(), "copy_file_range");
+                        }
+                        length -= n;
+                    }
+#endif
+                    if (length > 0) {
+                        copy_range_rw(in, in_offset, out, out_offset, length);
+                    }
+                }
+            }    // namespace detail
+
+            /**
+             * Writes a ceremony of tau_powers powers, taken as the prefix of a larger one, without decoding a
+             * single point: the first 2 * tau_powers - 1 elements of tau_g1 and the first tau_powers elements of
+             * the other vectors are copied byte for byte, as are beta_g2 and the public key. The proofs in the
+             * public key only refer to tau^1, alpha and beta, so a reduced response still verifies against the
+             * equally reduced challenge.
+             */
+            inline void reduce(const std::string &input_path,
+                               const accumulator_layout &input,
+                               std::uint32_t curve,
+                               const std::string &output_path,
+                               std::size_t tau_powers) {
+                if (tau_powers < 2 || tau_powers > input.tau_powers) {
+                    throw std::invalid_argument("the reduced ceremony must have between 2 and " +
+                                                std::to_string(input.tau_powers) + " powers");
+                }
+
+                container_header header {
+                    container_version, curve,
+                    accumulator_layout::container(tau_powers, input[section::tau_g1].element_size,
+                                                  input[section::tau_g2].element_size,
+                                                  input[section::public_key].length())};
+                // The points are copied as they are, native ones along with the fingerprint they were written under.
+                header.layout.format = input.format;
+
+                file_descriptor in(input_path, O_RDONLY);
+                file_descriptor out(output_path, O_WRONLY | O_CREAT | O_EXCL, 0644);
+
+                if (::ftruncate(out.get(), header.layout.length) != 0) {
+                    throw std::system_error(errno, std::generic_category(), output_path);
+                }
+                std::vector<std::uint8_t> page = encode_container_header(header);
+                if (::pwrite(out.get(), page.data(), page.size(), 0) != static_cast<ssize_t>(page.size())) {
+                    throw std::system_error(errno, std::generic_category(), output_path);
+                }
+
+                for (std::size_t i = 0; i < sections_count; ++i) {
+                    const section_extent &from = input.sections[i];
+                    const section_extent &to = header.layout.sections[i];
+                    detail::copy_range(in.get(), from.offset, out.get(), to.offset, to.length());
+                }
+            }
+        }    // namespace cli
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_REDUCE_HPP
@@ -0,0 +1,289 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_SCHEDULER_HPP
+#define CRYPTO3_CLI_SCHEDULER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+
+            /**
+             * Relative cost of processing one element of a range. parallel_for cuts ranges into chunks of roughly
+             * equal work, so a G2 range is split three times finer than a G1 range of the same length and both
+             * finish together when they share a task group.
+             */
+            enum class task_cost : std::size_t {
+                g1 = 1,
+                g2 = 3,
+                pairing = 10,
+            };
+
+            class task_group;
+
+            /**
+             * Work-stealing scheduler shared by every subcommand. The thread which waits on a task_group is one of
+             * the participants, so a scheduler created for N threads spawns N - 1 workers and never runs more than
+             * N tasks at once, however deeply parallel sections are nested.
+             */
+            class scheduler {
+                friend class task_group;
+
+                struct task {
+                    task_group *group;
+                    std::function<void()> body;
+                };
+
+                struct worker_queue {
+                    std::mutex mutex;
+                    std::deque<task> tasks;
+                };
+
+            public:
+                explicit scheduler(std::size_t threads = std::thread::hardware_concurrency()) {
+                    threads = std::max<std::size_t>(threads, 1);
+                    for (std::size_t i = 0; i < threads; ++i) {
+                        queues.emplace_back(std::make_unique<worker_queue>());
+                    }
+                    for (std::size_t i = 1; i < threads; ++i) {
+                        workers.emplace_back([this, i]() { worker_loop(i); });
+                    }
+                }
+
+                scheduler(const scheduler &) = delete;
+                scheduler &operator=(const scheduler &) = delete;
+
+                ~scheduler() {
+                    {
+                        std::lock_guard<std::mutex> lock(idle_mutex);
+                        stopping = true;
+                    }
+                    idle.notify_all();
+                    for (auto &worker : workers) {
+                        worker.join();
+                    }
+                }
+
+                std::size_t concurrency() const {
+                    return queues.size();
+                }
+
+            private:
+                void submit(task t) {
+                    // Workers push to their own deque so nested tasks stay hot in cache; any other thread feeds the
+                    // external queue.
+                    std::size_t index = current_scheduler == this ? current_queue : 0;
+                    // Counted before it is pushed, so the pop which takes it can't bring queued below zero.
+                    {
+                        std::lock_guard<std::mutex> lock(idle_mutex);
+                        ++queued;
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+                        queues[index]->tasks.emplace_back(std::move(t));
+                    }
+                    idle.notify_one();
+                }
+
+                bool pop(task &t) {
+                    std::size_t self = current_scheduler == this ? current_queue : 0;
+                    {
+                        std::lock_guard<std::mutex> lock(queues[self]->mutex);
+                        if (!queues[self]->tasks.empty()) {
+                            t = std::move(queues[self]->tasks.back());
+                            queues[self]->tasks.pop_back();
+                            --queued;
+                            return true;
+                        }
+                    }
+                    for (std::size_t i = 1; i < queues.size(); ++i) {
+                        worker_queue &victim = *queues[(self + i) % queues.size()];
+                        std::lock_guard<std::mutex> lock(victim.mutex);
+                        if (!victim.tasks.empty()) {
+                            t = std::move(victim.tasks.front());
+                            victim.tasks.pop_front();
+                            --queued;
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+                inline bool try_run_one();
+
+                void worker_loop(std::size_t index) {
+                    current_scheduler = this;
+                    current_queue = index;
+                    while (true) {
+                        if (try_run_one()) {
+                            continue;
+                        }
+                        std::unique_lock<std::mutex> lock(idle_mutex);
+                        idle.wait(lock, [this]() { return stopping || queued > 0; });
+                        if (stopping && queued == 0) {
+                            return;
+                        }
+                    }
+                }
+
+                std::vector<std::unique_ptr<worker_queue>> queues;
+                std::vector<std::thread> workers;
+
+                std::mutex idle_mutex;
+                std::condition_variable idle;
+                std::atomic<std::size_t> queued {0};
+                bool stopping = false;
+
+                static inline thread_local const scheduler *current_scheduler = nullptr;
+                static inline thread_local std::size_t current_queue = 0;
+            };
+
+            /**
+             * Fork-join scope on a scheduler. The first exception thrown by a task cancels the group: tasks which
+             * have not started yet are skipped and wait() rethrows the exception once the running ones return.
+             */
+            class task_group {
+                friend class scheduler;
+
+            public:
+                explicit task_group(scheduler &s) : sched(s) {
+                }
+
+                task_group(const task_group &) = delete;
+                task_group &operator=(const task_group &) = delete;
+
+                ~task_group() {
+                    // Only reached with pending tasks when the owner unwinds before wait(); they must not outlive us.
+                    if (pending > 0) {
+                        cancel();
+                        join();
+                    }
+                }
+
+                template<typename Function>
+                void run(Function &&f) {
+                    ++pending;
+                    sched.submit({this, std::forward<Function>(f)});
+                }
+
+                void wait() {
+                    join();
+                    if (error) {
+                        std::exception_ptr e = std::exchange(error, nullptr);
+                        std::rethrow_exception(e);
+                    }
+                }
+
+                void cancel() {
+                    cancelled = true;
+                }
+
+                bool is_cancelled() const {
+                    return cancelled;
+                }
+
+                scheduler &get_scheduler() const {
+                    return sched;
+                }
+
+            private:
+                void join() {
+                    // The waiting thread helps with any queued task rather than sleeping, which is what makes nested
+                    // parallel sections safe on a fixed number of threads.
+                    while (pending > 0) {
+                        if (sched.try_run_one()) {
+                            continue;
+                        }
+                        std::unique_lock<std::mutex> lock(sched.idle_mutex);
+                        sched.idle.wait(lock, [this]() { return pending == 0 || sched.queued > 0; });
+                    }
+                }
+
+                void execute(std::function<void()> &body) {
+                    if (!cancelled) {
+                        try {
+                            body();
+                        } catch (...) {
+                            std::lock_guard<std::mutex> lock(error_mutex);
+                            if (!error) {
+                                error = std::current_exception();
+                            }
+                            cancelled = true;
+                        }
+                    }
+                    // Once pending is zero the owner may return from wait() and destroy the group, so nothing of
+                    // it is touched after the decrement.
+                    scheduler &s = sched;
+                    if (--pending == 0) {
+                        std::lock_guard<std::mutex> lock(s.idle_mutex);
+                        s.idle.notify_all();
+                    }
+                }
+
+                scheduler &sched;
+                std::atomic<std::size_t> pending {0};
+                std::atomic<bool> cancelled {false};
+                std::mutex error_mutex;
+                std::exception_ptr error;
+            };
+
+            inline bool scheduler::try_run_one() {
+                task t;
+                if (!pop(t)) {
+                    return false;
+                }
+                t.group->execute(t.body);
+                return true;
+            }
+
+            /**
+             * Splits [first, last) into chunks of roughly equal work and runs f(chunk_first, chunk_last) for each of
+             * them in group. Returns immediately; call group.wait() to join. Bodies may open nested groups.
+             */
+            template<typename Function>
+            void parallel_for(task_group &group, std::size_t first, std::size_t last, task_cost cost, Function f) {
+                constexpr std::size_t chunk_work = 256;
+
+                if (first >= last) {
+                    return;
+                }
+                std::size_t weight = static_cast<std::size_t>(cost);
+                std::size_t grain = std::max<std::size_t>(chunk_work / weight, 1);
+                std::size_t chunks = (last - first + grain - 1) / grain;
+                // Short ranges still deserve every thread.
+                chunks = std::max(chunks, std::min(last - first, group.get_scheduler().concurrency() * weight));
+                std::size_t step = (last - first + chunks - 1) / chunks;
+
+                for (std::size_t begin = first; begin < last; begin += step) {
+                    std::size_t end = std::min(begin + step, last);
+                    group.run([f, begin, end]() { f(begin, end); });
+                }
+            }
+
+            template<typename Function>
+            void parallel_for(scheduler &s, std::size_t first, std::size_t last, task_cost cost, Function f) {
+                task_group group(s);
+                parallel_for(group, first, last, cost, std::move(f));
+                group.wait();
+            }
+        }    // namespace cli
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_SCHEDULER_HPP
@@ -0,0 +1,135 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_SECTIONS_HPP
+#define CRYPTO3_CLI_SECTIONS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+
+            /// Sections of a serialized challenge or response, in file order.
+            enum class section : std::size_t {
+                tau_g1,
+                tau_g2,
+                alpha_tau_g1,
+                beta_tau_g1,
+                beta_g2,
+                public_key,
+            };
+
+            constexpr std::size_t accumulator_sections_count = 5;
+            constexpr std::size_t sections_count = 6;
+
+            /// Alignment of every section in the container format, the page size O_DIRECT transfers need.
+            constexpr std::size_t section_alignment = 4096;
+
+            enum class point_encoding : std::uint32_t {
+                compressed = 0,
+                uncompressed = 1,
+                /// Affine Montgomery coordinates as the arithmetic kernels hold them; never sent to participants.
+                native = 2,
+            };
+
+            /// How the points of every section are encoded; fingerprint names the build that wrote native ones.
+            struct point_format {
+                point_encoding encoding;
+                std::uint64_t fingerprint;
+
+                bool is_native() const {
+                    return encoding == point_encoding::native;
+                }
+            };
+
+            struct section_extent {
+                std::size_t offset;
+                std::size_t count;
+                std::size_t element_size;
+
+                std::size_t length() const {
+                    return count * element_size;
+                }
+            };
+
+            /**
+             * Byte layout of a serialized challenge or response. Every section is a run of fixed-size point
+             * encodings, so the position of any power follows from its index. The public key is a single
+             * element and is empty for challenges.
+             */
+            struct accumulator_layout {
+                std::size_t tau_powers;
+                std::array<section_extent, sections_count> sections;
+                std::size_t length;
+                point_format format = {point_encoding::compressed, 0};
+
+                const section_extent &operator[](section s) const {
+                    return sections[static_cast<std::size_t>(s)];
+                }
+
+                bool has_public_key() const {
+                    return (*this)[section::public_key].count != 0;
+                }
+
+                /**
+                 * Layout of the plain marshalling stream: four power vectors, each optionally preceded by a
+                 * length prefix of prefix_size bytes, then beta_g2 and the public key.
+                 */
+                static accumulator_layout stream(std::size_t tau_powers,
+                                                 std::size_t g1_size,
+                                                 std::size_t g2_size,
+                                                 std::size_t prefix_size,
+                                                 std::size_t public_key_size) {
+                    accumulator_layout layout {tau_powers, {}, 0};
+                    std::size_t offset = 0;
+                    auto append = [&](section s, std::size_t count, std::size_t element_size, std::size_t prefix) {
+                        offset += prefix;
+                        layout.sections[static_cast<std::size_t>(s)] = {offset, count, element_size};
+                        offset += count * element_size;
+                    };
+                    append(section::tau_g1, 2 * tau_powers - 1, g1_size, prefix_size);
+                    append(section::tau_g2, tau_powers, g2_size, prefix_size);
+                    append(section::alpha_tau_g1, tau_powers, g1_size, prefix_size);
+                    append(section::beta_tau_g1, tau_powers, g1_size, prefix_size);
+                    append(section::beta_g2, 1, g2_size, 0);
+                    append(section::public_key, public_key_size != 0 ? 1 : 0, public_key_size, 0);
+                    layout.length = offset;
+                    return layout;
+                }
+
+                /// Layout of the container format: a header page, then every section on its own aligned offset.
+                static accumulator_layout container(std::size_t tau_powers,
+                                                    std::size_t g1_size,
+                                                    std::size_t g2_size,
+                                                    std::size_t public_key_size) {
+                    accumulator_layout layout {tau_powers, {}, 0};
+                    std::size_t offset = section_alignment;
+                    auto append = [&](section s, std::size_t count, std::size_t element_size) {
+                        layout.sections[static_cast<std::size_t>(s)] = {offset, count, element_size};
+                        offset = align(offset + count * element_size);
+                    };
+                    append(section::tau_g1, 2 * tau_powers - 1, g1_size);
+                    append(section::tau_g2, tau_powers, g2_size);
+                    append(section::alpha_tau_g1, tau_powers, g1_size);
+                    append(section::beta_tau_g1, tau_powers, g1_size);
+                    append(section::beta_g2, 1, g2_size);
+                    append(section::public_key, public_key_size != 0 ? 1 : 0, public_key_size);
+                    layout.length = offset;
+                    return layout;
+                }
+
+                static std::size_t align(std::size_t offset) {
+                    return (offset + section_alignment - 1) / section_alignment * section_alignment;
+                }
+            };
+        }    // namespace cli
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_SECTIONS_HPP
@@ -0,0 +1,83 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_TRANSFORM_HPP
+#define CRYPTO3_CLI_TRANSFORM_HPP
+
+#include <cstddef>
+
+#include <nil/crypto3/cli/arithmetic/curve_kernels.hpp>
+#include <nil/crypto3/cli/scheduler.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace detail {
+
+                /**
+                 * Multiplies points[first, last) by factor * tau^i, tau^first computed directly so chunks are
+                 * independent of each other. The points of a chunk are multiplied as one batch, so the kernels
+                 * can run several points per instruction stream.
+                 */
+                template<typename CurveType, typename Points, typename ScalarValueType>
+                void multiply_by_powers(Points &points,
+                                        std::size_t first,
+                                        std::size_t last,
+                                        const ScalarValueType &tau,
+                                        const ScalarValueType &factor) {
+                    arithmetic::curve_kernels<CurveType>::multiply_by_powers(points.data() + first, last - first,
+                                                                             factor, tau, first);
+                }
+            }    // namespace detail
+
+            /**
+             * Parallel equivalent of accumulator_type::transform: multiplies the i-th power of every vector by
+             * tau^i (times alpha or beta where appropriate). Each chunk starts from tau^first, so chunks are
+             * independent and the result is identical to the sequential update.
+             */
+            template<typename SchemeType>
+            void transform(scheduler &s,
+                           typename SchemeType::accumulator_type &acc,
+                           const typename SchemeType::private_key_type &private_key) {
+                using curve_type = typename SchemeType::curve_type;
+                using scalar_field_value_type = typename curve_type::scalar_field_type::value_type;
+
+                const scalar_field_value_type one = scalar_field_value_type::one();
+                task_group group(s);
+
+                parallel_for(group, 0, acc.tau_powers_g1.size(), task_cost::g1,
+                             [&acc, &private_key, &one](std::size_t first, std::size_t last) {
+                                 detail::multiply_by_powers<curve_type>(acc.tau_powers_g1, first, last,
+                                                                        private_key.tau, one);
+                             });
+
+                parallel_for(group, 0, acc.tau_powers_g2.size(), task_cost::g2,
+                             [&acc, &private_key, &one](std::size_t first, std::size_t last) {
+                                 detail::multiply_by_powers<curve_type>(acc.tau_powers_g2, first, last,
+                                                                        private_key.tau, one);
+                             });
+
+                parallel_for(group, 0, acc.alpha_tau_powers_g1.size(), task_cost::g1,
+                             [&acc, &private_key](std::size_t first, std::size_t last) {
+                                 detail::multiply_by_powers<curve_type>(acc.alpha_tau_powers_g1, first, last,
+                                                                        private_key.tau, private_key.alpha);
+                             });
+
+                parallel_for(group, 0, acc.beta_tau_powers_g1.size(), task_cost::g1,
+                             [&acc, &private_key](std::size_t first, std::size_t last) {
+                                 detail::multiply_by_powers<curve_type>(acc.beta_tau_powers_g1, first, last,
+                                                                        private_key.tau, private_key.beta);
+                             });
+
+                group.run([&acc, &private_key]() { acc.beta_g2 = private_key.beta * acc.beta_g2; });
+
+                group.wait();
+            }
+        }    // namespace cli
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_TRANSFORM_HPP
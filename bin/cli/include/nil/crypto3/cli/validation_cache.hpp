@@ -0,0 +1,264 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_VALIDATION_CACHE_HPP
+#define CRYPTO3_CLI_VALIDATION_CACHE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <nil/crypto3/cli/scheduler.hpp>
+#include <nil/crypto3/cli/sections.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+
+            using content_digest = std::array<std::uint8_t, 32>;
+
+            namespace detail {
+                /// SHA-256 (FIPS 180-4).
+                class sha256 {
+                public:
+                    void update(const std::uint8_t *data, std::size_t length) {
+                        total += length;
+                        if (buffered != 0) {
+                            std::size_t n = std::min(length, block.size() - buffered);
+                            std::copy(data, data + n, block.begin() + buffered);
+                            buffered += n;
+                            data += n;
+                            length -= n;
+                            if (buffered < block.size()) {
+                                return;
+                            }
+                            compress(block.data());
+                            buffered = 0;
+                        }
+                        for (; length >= block.size(); data += block.size(), length -= block.size()) {
+                            compress(data);
+                        }
+                        std::copy(data, data + length, block.begin());
+                        buffered = length;
+                    }
+
+                    content_digest finish() {
+                        std::uint64_t bits = 8 * total;
+                        std::uint8_t padding[72] = {0x80};
+                        update(padding, 1 + (119 - total % 64) % 64);
+                        std::uint8_t length[8];
+                        for (std::size_t i = 0; i < 8; ++i) {
+                            length[i] = static_cast<std::uint8_t>(bits >> (56 - 8 * i));
+                        }
+                        update(length, 8);
+                        content_digest digest;
+                        for (std::size_t i = 0; i < 32; ++i) {
+                            digest[i] = static_cast<std::uint8_t>(state[i / 4] >> (24 - 8 * (i % 4)));
+                        }
+                        return digest;
+                    }
+
+                private:
+                    static std::uint32_t rotr(std::uint32_t x, unsigned n) {
+                        return (x >> n) | (x << (32 - n));
+                    }
+
+                    void compress(const std::uint8_t *p) {
+                        constexpr static const std::uint32_t k[64] = {
+                            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4,
+                            0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe,
+                            0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f,
+                            0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+                            0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
+                            0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+                            0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116,
+                            0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+                            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7,
+                            0xc67178f2};
+
+                        std::uint32_t w[64];
+                        for (std::size_t i = 0; i < 16; ++i) {
+                            w[i] = (std::uint32_t(p[4 * i]) << 24) | (std::uint32_t(p[4 * i + 1]) << 16) |
+                                   (std::uint32_t(p[4 * i + 2]) << 8) | p[4 * i + 3];
+                        }
+                        for (std::size_t i = 16; i < 64; ++i) {
+                            std::uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+                            std::uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+                            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+                        }
+
+                        std::uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+                        std::uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+                        for (std::size_t i = 0; i < 64; ++i) {
+                            std::uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) +
+                                               k[i] + w[i];
+                            std::uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+                            h = g;
+                            g = f;
+                            f = e;
+                            e = d + t1;
+                            d = c;
+                            c = b;
+                            b = a;
+                            a = t1 + t2;
+                        }
+                        state[0] += a;
+                        state[1] += b;
+                        state[2] += c;
+                        state[3] += d;
+                        state[4] += e;
+                        state[5] += f;
+                        state[6] += g;
+                        state[7] += h;
+                    }
+
+                    std::array<std::uint32_t, 8> state = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                                          0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+                    std::array<std::uint8_t, 64> block {};
+                    std::size_t buffered = 0;
+                    std::uint64_t total = 0;
+                };
+            }    // namespace detail
+
+            /// Records of a section one digest covers; chunks are counted from the start of the section.
+            constexpr std::size_t validation_chunk_records = 1024;
+
+            /**
+             * Digest of count records of element_size bytes in format. What records decode to depends on their
+             * bytes and on the format they are in, so equal digests mean equal points.
+             */
+            inline content_digest records_digest(const point_format &format,
+                                                 std::size_t element_size,
+                                                 const std::uint8_t *records,
+                                                 std::size_t count) {
+                const std::uint64_t fields[3] = {static_cast<std::uint64_t>(format.encoding), format.fingerprint,
+                                                  static_cast<std::uint64_t>(element_size)};
+                std::uint8_t prefix[sizeof(fields)];
+                for (std::size_t i = 0; i < sizeof(prefix); ++i) {
+                    prefix[i] = static_cast<std::uint8_t>(fields[i / 8] >> (8 * (i % 8)));
+                }
+                detail::sha256 digest;
+                digest.update(prefix, sizeof(prefix));
+                digest.update(records, count * element_size);
+                return digest.finish();
+            }
+
+            inline std::string to_hex(const content_digest &digest) {
+                constexpr const char digits[] = "0123456789abcdef";
+                std::string hex;
+                for (std::uint8_t b : digest) {
+                    hex += digits[b >> 4];
+                    hex += digits[b & 0xf];
+                }
+                return hex;
+            }
+
+            /**
+             * Digests of the chunks of records whose points this host checked in full, one hex digest per line
+             * of a local text file. A chunk whose bytes have a listed digest decodes to points which passed the
+             * subgroup check before, so loading it again only needs the cheap on-curve checks. The digest is
+             * taken over the very bytes which are then decoded, so nothing is trusted that wasn't checked,
+             * whatever file it comes from. Safe to share between threads.
+             */
+            class validation_cache {
+            public:
+                explicit validation_cache(const std::string &path) : path(path) {
+                    std::ifstream in(path);
+                    std::string line;
+                    while (std::getline(in, line)) {
+                        content_digest digest;
+                        if (from_hex(line, digest)) {
+                            digests.insert(digest);
+                        }
+                    }
+                }
+
+                bool contains(const content_digest &digest) const {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    return digests.count(digest) != 0;
+                }
+
+                void insert(const content_digest &digest) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (digests.insert(digest).second) {
+                        added.push_back(digest);
+                    }
+                }
+
+                /// Appends the digests inserted since the list was read to its file.
+                void save() {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    std::ofstream out(path, std::ios_base::app);
+                    for (const content_digest &digest : added) {
+                        out << to_hex(digest) << '\n';
+                    }
+                    if (!out) {
+                        throw std::runtime_error("failed to write " + path);
+                    }
+                    added.clear();
+                }
+
+            private:
+                static bool from_hex(const std::string &hex, content_digest &digest) {
+                    if (hex.size() != 2 * digest.size()) {
+                        return false;
+                    }
+                    auto nibble = [](char c) {
+                        return c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : -1;
+                    };
+                    for (std::size_t i = 0; i < digest.size(); ++i) {
+                        int high = nibble(hex[2 * i]), low = nibble(hex[2 * i + 1]);
+                        if (high < 0 || low < 0) {
+                            return false;
+                        }
+                        digest[i] = static_cast<std::uint8_t>(16 * high + low);
+                    }
+                    return true;
+                }
+
+                std::string path;
+                mutable std::mutex mutex;
+                std::set<content_digest> digests;
+                std::vector<content_digest> added;
+            };
+
+            /**
+             * Runs f(chunk_first, chunk_count, whole) in parallel for the part of every validation chunk of a
+             * section of section_count records which [first, first + count) overlaps. whole says whether that
+             * part is the entire chunk; only entire chunks have a digest to look up.
+             */
+            template<typename Function>
+            void for_each_validation_chunk(scheduler &s,
+                                           std::size_t section_count,
+                                           std::size_t first,
+                                           std::size_t count,
+                                           Function f) {
+                const std::size_t last = first + count;
+                const std::size_t first_chunk = first / validation_chunk_records;
+                const std::size_t last_chunk = (last + validation_chunk_records - 1) / validation_chunk_records;
+                // A chunk is far more work than a point: give each one a task of its own.
+                parallel_for(s, first_chunk, last_chunk, task_cost::pairing, [&](std::size_t begin, std::size_t end) {
+                    for (std::size_t chunk = begin; chunk < end; ++chunk) {
+                        std::size_t chunk_first = chunk * validation_chunk_records;
+                        std::size_t chunk_last = std::min(chunk_first + validation_chunk_records, section_count);
+                        std::size_t part_first = std::max(chunk_first, first);
+                        std::size_t part_last = std::min(chunk_last, last);
+                        f(part_first, part_last - part_first, part_first == chunk_first && part_last == chunk_last);
+                    }
+                });
+            }
+        }    // namespace cli
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_VALIDATION_CACHE_HPP
@@ -0,0 +1,487 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CLI_VERIFY_HPP
+#define CRYPTO3_CLI_VERIFY_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <nil/crypto3/algebra/random_element.hpp>
+
+#include <nil/crypto3/cli/arena.hpp>
+#include <nil/crypto3/cli/arithmetic/curve_kernels.hpp>
+#include <nil/crypto3/cli/arithmetic/pairing_kernels.hpp>
+#include <nil/crypto3/cli/scheduler.hpp>
+#include <nil/crypto3/cli/sections.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace detail {
+
+                /// The claim e(g1.first, g2.second) = e(g1.second, g2.first), both sides in the same ratio.
+                template<typename G1ValueType, typename G2ValueType>
+                struct ratio {
+                    std::pair<G1ValueType, G1ValueType> g1;
+                    std::pair<G2ValueType, G2ValueType> g2;
+                };
+
+                /// A single claim as e(g1.first, g2.second) e(-g1.second, g2.first) = 1, one final exponentiation.
+                template<typename CurveType, typename G1ValueType, typename G2ValueType>
+                bool same_ratio(const std::pair<G1ValueType, G1ValueType> &g1_ratio,
+                                const std::pair<G2ValueType, G2ValueType> &g2_ratio) {
+                    using pairing_type = arithmetic::pairing_kernels<CurveType>;
+
+                    const G1ValueType p[2] = {g1_ratio.first, -g1_ratio.second};
+                    auto second = arithmetic::prepared_g2<CurveType>().get(g2_ratio.second);
+                    auto first = arithmetic::prepared_g2<CurveType>().get(g2_ratio.first);
+                    const typename pairing_type::prepared_type *q[2] = {second.get(), first.get()};
+                    return pairing_type::is_one(pairing_type::miller_loop(p, q, 2));
+                }
+
+                /**
+                 * Checks all claims at once: the product over i of (e(a_i, d_i) / e(b_i, c_i))^(r_i) with fresh
+                 * random r_i is one, which holds for a false claim with probability 1 / |Fr|. r_i a_i and
+                 * -r_i b_i go through the batched scalar multiplication, and the G2 points, most of which appear
+                 * in several claims, come prepared from the shared cache. The Miller loops of all pairs run in
+                 * chunks on the scheduler and a single final exponentiation decides the product.
+                 */
+                template<typename CurveType, typename G1ValueType, typename G2ValueType>
+                bool same_ratios(scheduler &s, const std::vector<ratio<G1ValueType, G2ValueType>> &ratios) {
+                    using scalar_field_type = typename CurveType::scalar_field_type;
+                    using pairing_type = arithmetic::pairing_kernels<CurveType>;
+                    using miller_loop_type = typename pairing_type::miller_loop_type;
+                    using prepared_type = typename pairing_type::prepared_type;
+
+                    const std::size_t n = ratios.size();
+                    std::vector<G1ValueType> p(2 * n);
+                    std::vector<std::shared_ptr<const prepared_type>> prepared(2 * n);
+                    std::vector<const prepared_type *> q(2 * n);
+                    std::vector<typename scalar_field_type::value_type> r(2 * n);
+                    for (std::size_t i = 0; i < n; ++i) {
+                        r[i] = algebra::random_element<scalar_field_type>();
+                        r[n + i] = -r[i];
+                        p[i] = ratios[i].g1.first;
+                        p[n + i] = ratios[i].g1.second;
+                        prepared[i] = arithmetic::prepared_g2<CurveType>().get(ratios[i].g2.second);
+                        prepared[n + i] = arithmetic::prepared_g2<CurveType>().get(ratios[i].g2.first);
+                    }
+                    for (std::size_t i = 0; i < q.size(); ++i) {
+                        q[i] = prepared[i].get();
+                    }
+                    // The random coefficients only need to be unknown when the transcript was written, which they
+                    // were; nothing here is secret, so the variable-time kernels apply.
+                    arithmetic::curve_kernels<CurveType, arithmetic::variable_time>::multiply(p.data(), r.data(),
+                                                                                              p.size());
+
+                    miller_loop_type f = pairing_type::one();
+                    std::mutex f_mutex;
+                    parallel_for(s, 0, p.size(), task_cost::pairing, [&](std::size_t first, std::size_t last) {
+                        miller_loop_type chunk =
+                            pairing_type::miller_loop(p.data() + first, q.data() + first, last - first);
+                        std::lock_guard<std::mutex> lock(f_mutex);
+                        f = pairing_type::multiply(f, chunk);
+                    });
+                    return pairing_type::is_one(f);
+                }
+
+                /**
+                 * Compresses the consecutive pairs (v[i], v[i + 1]) for i in [first, last) into a single pair with
+                 * fresh random coefficients, so one ratio claim covers the whole range. The chunks run in group and
+                 * whichever of them completes the range hands the pair to done, from its own task.
+                 */
+                template<typename CurveType, typename Range, typename Done>
+                void power_pairs(task_group &group,
+                                 const Range &v,
+                                 std::size_t first,
+                                 std::size_t last,
+                                 task_cost cost,
+                                 Done done) {
+                    using scalar_field_type = typename CurveType::scalar_field_type;
+                    using value_type = typename std::decay<decltype(v[0])>::type;
+
+                    struct sums {
+                        value_type s = value_type::zero();
+                        value_type sx = value_type::zero();
+                        std::size_t remaining;
+                        std::mutex mutex;
+                    };
+                    auto acc = std::make_shared<sums>();
+                    acc->remaining = last - first;
+
+                    parallel_for(group, first, last, cost, [&v, acc, done](std::size_t begin, std::size_t end) {
+                        // v[begin, end] is gathered once; the two sums are its two overlapping windows.
+                        scratch_scope scratch;
+                        scratch_vector<value_type> points(end - begin + 1, scratch.resource());
+                        scratch_vector<typename scalar_field_type::value_type> r(end - begin, scratch.resource());
+                        for (std::size_t i = begin; i <= end; ++i) {
+                            points[i - begin] = v[i];
+                        }
+                        for (auto &coefficient : r) {
+                            coefficient = algebra::random_element<scalar_field_type>();
+                        }
+                        using kernels_type = arithmetic::curve_kernels<CurveType, arithmetic::variable_time>;
+                        value_type chunk_s = kernels_type::multi_multiply(points.data(), r.data(), r.size());
+                        value_type chunk_sx = kernels_type::multi_multiply(points.data() + 1, r.data(), r.size());
+                        {
+                            std::lock_guard<std::mutex> lock(acc->mutex);
+                            acc->s = acc->s + chunk_s;
+                            acc->sx = acc->sx + chunk_sx;
+                            acc->remaining -= end - begin;
+                            if (acc->remaining != 0) {
+                                return;
+                            }
+                        }
+                        done(std::make_pair(acc->s, acc->sx));
+                    });
+                }
+
+                /// power_pairs over [first, last), waited for.
+                template<typename CurveType, typename Range>
+                auto power_pairs(scheduler &s, const Range &v, std::size_t first, std::size_t last, task_cost cost) {
+                    using value_type = typename std::decay<decltype(v[0])>::type;
+
+                    std::pair<value_type, value_type> result = {value_type::zero(), value_type::zero()};
+                    task_group group(s);
+                    power_pairs<CurveType>(group, v, first, last, cost,
+                                           [&](const std::pair<value_type, value_type> &pairs) { result = pairs; });
+                    group.wait();
+                    return result;
+                }
+
+                /**
+                 * Narrows the pairs in [first, last), which fail holds, down to single failing pairs and appends
+                 * them to failing, merging neighbours into runs. Each range is split in two with fresh random
+                 * coefficients; when the first half holds the second must fail and isn't checked again. Stops
+                 * once limit pairs have been found.
+                 */
+                template<typename Holds>
+                void bisect(std::size_t first,
+                            std::size_t last,
+                            Holds &holds,
+                            std::size_t limit,
+                            std::size_t &found,
+                            std::vector<std::pair<std::size_t, std::size_t>> &failing) {
+                    if (found >= limit) {
+                        return;
+                    }
+                    if (last - first == 1) {
+                        ++found;
+                        if (!failing.empty() && failing.back().second == first) {
+                            failing.back().second = last;
+                        } else {
+                            failing.emplace_back(first, last);
+                        }
+                        return;
+                    }
+                    std::size_t middle = first + (last - first) / 2;
+                    if (holds(first, middle)) {
+                        bisect(middle, last, holds, limit, found, failing);
+                        return;
+                    }
+                    bisect(first, middle, holds, limit, found, failing);
+                    if (found < limit && !holds(middle, last)) {
+                        bisect(middle, last, holds, limit, found, failing);
+                    }
+                }
+
+                /// Whether acc holds the powers of one ceremony: 2 N - 1 in tau_g1, N in the others, N at least 2.
+                template<typename Accumulator>
+                bool well_formed(const Accumulator &acc) {
+                    std::size_t n = acc.tau_powers_g2.size();
+                    return n >= 2 && acc.tau_powers_g1.size() == 2 * n - 1 && acc.alpha_tau_powers_g1.size() == n &&
+                           acc.beta_tau_powers_g1.size() == n;
+                }
+
+                /**
+                 * The claims of verify on single points: the proofs of knowledge of tau, alpha and beta, then the
+                 * new accumulator being the old one transformed by the proven secrets. The G2 halves of the proofs
+                 * are derived from the G1 halves by the scheme, exactly as on the contributor's side.
+                 */
+                template<typename SchemeType, typename Accumulator>
+                auto point_claims(const typename SchemeType::public_key_type &public_key,
+                                  const Accumulator &before,
+                                  const Accumulator &after) {
+                    using curve_type = typename SchemeType::curve_type;
+                    using g1_value_type = typename curve_type::template g1_type<>::value_type;
+                    using g2_value_type = typename curve_type::template g2_type<>::value_type;
+
+                    g2_value_type tau_g2_s =
+                        SchemeType::compute_g2_s(public_key.tau_pok.g1_s, public_key.tau_pok.g1_s_x, 0);
+                    g2_value_type alpha_g2_s =
+                        SchemeType::compute_g2_s(public_key.alpha_pok.g1_s, public_key.alpha_pok.g1_s_x, 1);
+                    g2_value_type beta_g2_s =
+                        SchemeType::compute_g2_s(public_key.beta_pok.g1_s, public_key.beta_pok.g1_s_x, 2);
+
+                    return std::vector<ratio<g1_value_type, g2_value_type>> {
+                        {{public_key.tau_pok.g1_s, public_key.tau_pok.g1_s_x}, {tau_g2_s, public_key.tau_pok.g2_s_x}},
+                        {{public_key.alpha_pok.g1_s, public_key.alpha_pok.g1_s_x},
+                         {alpha_g2_s, public_key.alpha_pok.g2_s_x}},
+                        {{public_key.beta_pok.g1_s, public_key.beta_pok.g1_s_x},
+                         {beta_g2_s, public_key.beta_pok.g2_s_x}},
+                        {{before.tau_powers_g1[1], after.tau_powers_g1[1]}, {tau_g2_s, public_key.tau_pok.g2_s_x}},
+                        {{before.alpha_tau_powers_g1[0], after.alpha_tau_powers_g1[0]},
+                         {alpha_g2_s, public_key.alpha_pok.g2_s_x}},
+                        {{before.beta_tau_powers_g1[0], after.beta_tau_powers_g1[0]},
+                         {beta_g2_s, public_key.beta_pok.g2_s_x}},
+                        {{public_key.beta_pok.g1_s, public_key.beta_pok.g1_s_x}, {before.beta_g2, after.beta_g2}},
+                    };
+                }
+
+                /// The claims of verify, which only read the first powers of before.
+                template<typename SchemeType, typename Accumulator>
+                bool holds_transform(scheduler &s,
+                                     const typename SchemeType::public_key_type &public_key,
+                                     const Accumulator &before,
+                                     const Accumulator &after,
+                                     bool fail_fast) {
+                    using curve_type = typename SchemeType::curve_type;
+                    using g1_value_type = typename curve_type::template g1_type<>::value_type;
+                    using g2_value_type = typename curve_type::template g2_type<>::value_type;
+                    using ratio_type = detail::ratio<g1_value_type, g2_value_type>;
+                    using g1_pair = std::pair<g1_value_type, g1_value_type>;
+                    using g2_pair = std::pair<g2_value_type, g2_value_type>;
+
+                    // The ceremony must not have been reset to trivial powers.
+                    if (!(after.tau_powers_g1[0] == g1_value_type::one() &&
+                          after.tau_powers_g2[0] == g2_value_type::one())) {
+                        return false;
+                    }
+
+                    std::vector<ratio_type> ratios = detail::point_claims<SchemeType>(public_key, before, after);
+                    if (fail_fast && !detail::same_ratios<curve_type>(s, ratios)) {
+                        return false;
+                    }
+
+                    const g1_pair tau_g1 = {after.tau_powers_g1[0], after.tau_powers_g1[1]};
+                    const g2_pair tau_g2 = {after.tau_powers_g2[0], after.tau_powers_g2[1]};
+
+                    // Every vector holds consecutive powers of the same tau; the compressed vectors are the heavy part.
+                    g1_pair tau_g1_powers, alpha_g1_powers, beta_g1_powers;
+                    g2_pair tau_g2_powers;
+                    std::atomic<bool> failed {false};
+                    task_group group(s);
+                    auto settle = [&](const ratio_type &claim) {
+                        if (fail_fast && !detail::same_ratio<curve_type>(claim.g1, claim.g2)) {
+                            failed = true;
+                            group.cancel();
+                        }
+                    };
+                    detail::power_pairs<curve_type>(group, after.tau_powers_g1, 0, after.tau_powers_g1.size() - 1,
+                                                    task_cost::g1, [&](const g1_pair &pairs) {
+                                                        tau_g1_powers = pairs;
+                                                        settle({pairs, tau_g2});
+                                                    });
+                    detail::power_pairs<curve_type>(group, after.tau_powers_g2, 0, after.tau_powers_g2.size() - 1,
+                                                    task_cost::g2, [&](const g2_pair &pairs) {
+                                                        tau_g2_powers = pairs;
+                                                        settle({tau_g1, pairs});
+                                                    });
+                    detail::power_pairs<curve_type>(group, after.alpha_tau_powers_g1, 0,
+                                                    after.alpha_tau_powers_g1.size() - 1, task_cost::g1,
+                                                    [&](const g1_pair &pairs) {
+                                                        alpha_g1_powers = pairs;
+                                                        settle({pairs, tau_g2});
+                                                    });
+                    detail::power_pairs<curve_type>(group, after.beta_tau_powers_g1, 0,
+                                                    after.beta_tau_powers_g1.size() - 1, task_cost::g1,
+                                                    [&](const g1_pair &pairs) {
+                                                        beta_g1_powers = pairs;
+                                                        settle({pairs, tau_g2});
+                                                    });
+                    group.wait();
+
+                    if (fail_fast) {
+                        // Every claim has been checked on its own by now.
+                        return !failed;
+                    }
+                    ratios.push_back({tau_g1_powers, tau_g2});
+                    ratios.push_back({tau_g1, tau_g2_powers});
+                    ratios.push_back({alpha_g1_powers, tau_g2});
+                    ratios.push_back({beta_g1_powers, tau_g2});
+                    return detail::same_ratios<curve_type>(s, ratios);
+                }
+            }    // namespace detail
+
+            /**
+             * Checks a contribution the way SchemeType::verify_eval does, but with all of its ratio checks folded
+             * into one random linear combination: the compressed power vectors are computed concurrently on the
+             * scheduler, then a single multi-pairing with one final exponentiation checks every ratio. The vectors
+             * share one task group, so a point which fails to load cancels the work left on all of them.
+             *
+             * fail_fast gives up as early as a false claim can be seen instead: the claims on single points are
+             * checked before any vector is touched, and each vector's claim as soon as the vector is compressed,
+             * cancelling the rest. It costs a few more final exponentiations when the contribution is valid.
+             *
+             * A response which doesn't hold exactly as many powers as the challenge is invalid, whatever its points.
+             */
+            template<typename SchemeType, typename Accumulator>
+            bool verify(scheduler &s,
+                        const typename SchemeType::public_key_type &public_key,
+                        const Accumulator &before,
+                        const Accumulator &after,
+                        bool fail_fast = false) {
+                if (!detail::well_formed(after) || before.tau_powers_g1.size() != after.tau_powers_g1.size() ||
+                    before.tau_powers_g2.size() != after.tau_powers_g2.size() ||
+                    before.alpha_tau_powers_g1.size() != after.alpha_tau_powers_g1.size() ||
+                    before.beta_tau_powers_g1.size() != after.beta_tau_powers_g1.size()) {
+                    return false;
+                }
+                return detail::holds_transform<SchemeType>(s, public_key, before, after, fail_fast);
+            }
+
+            /**
+             * verify against the first powers of the challenge only, as cut by powers_prefix. Of the challenge,
+             * the claims read tau^1 in G1, alpha and beta in G1 and beta in G2 and nothing else, so a prefix of
+             * two powers decides them as the whole challenge would. That lets a contributor check the response
+             * it computed in place of the challenge without keeping a copy of the whole. The response is only
+             * required to be well formed and at least as long as the prefix: whether it has the challenge's size
+             * is for whoever holds both to check, with verify.
+             */
+            template<typename SchemeType, typename Accumulator>
+            bool verify_against_prefix(scheduler &s,
+                                       const typename SchemeType::public_key_type &public_key,
+                                       const Accumulator &prefix,
+                                       const Accumulator &after,
+                                       bool fail_fast = false) {
+                if (!detail::well_formed(prefix) || !detail::well_formed(after) ||
+                    prefix.tau_powers_g2.size() > after.tau_powers_g2.size()) {
+                    return false;
+                }
+                return detail::holds_transform<SchemeType>(s, public_key, prefix, after, fail_fast);
+            }
+
+            /// The first m powers of every vector of acc, a challenge for verify_against_prefix.
+            template<typename Accumulator>
+            Accumulator powers_prefix(const Accumulator &acc, std::size_t m) {
+                using g1_vector = decltype(acc.tau_powers_g1);
+                using g2_vector = decltype(acc.tau_powers_g2);
+                return Accumulator {g1_vector(acc.tau_powers_g1.begin(), acc.tau_powers_g1.begin() + 2 * m - 1),
+                                    g2_vector(acc.tau_powers_g2.begin(), acc.tau_powers_g2.begin() + m),
+                                    g1_vector(acc.alpha_tau_powers_g1.begin(), acc.alpha_tau_powers_g1.begin() + m),
+                                    g1_vector(acc.beta_tau_powers_g1.begin(), acc.beta_tau_powers_g1.begin() + m),
+                                    acc.beta_g2};
+            }
+
+            /// A claim of verify which doesn't hold, narrowed down to the powers [first, last] of a section.
+            struct inconsistency {
+                section where;
+                /// For the public key, the proof: 0 for tau, 1 for alpha, 2 for beta.
+                std::size_t first;
+                std::size_t last;
+                const char *reason;
+            };
+
+            /**
+             * Finds out what makes verify reject a contribution. The claims on single points are checked one by
+             * one; the claim on each power vector is bisected with successively smaller random linear
+             * combinations down to the consecutive powers which aren't in ratio tau, a power k out of place
+             * showing up as the powers k - 1 to k + 1. The search of a vector stops after limit such pairs, so a
+             * vector which is wrong throughout costs little more than verifying it. Sections which don't hold as
+             * many powers as the challenge are all that is reported of a response.
+             */
+            template<typename SchemeType, typename Accumulator>
+            std::vector<inconsistency> locate(scheduler &s,
+                                              const typename SchemeType::public_key_type &public_key,
+                                              const Accumulator &before,
+                                              const Accumulator &after,
+                                              std::size_t limit = 64) {
+                using curve_type = typename SchemeType::curve_type;
+                using g1_value_type = typename curve_type::template g1_type<>::value_type;
+                using g2_value_type = typename curve_type::template g2_type<>::value_type;
+                using g1_pair = std::pair<g1_value_type, g1_value_type>;
+                using g2_pair = std::pair<g2_value_type, g2_value_type>;
+
+                struct claim_site {
+                    section where;
+                    std::size_t index;
+                    const char *reason;
+                };
+                const claim_site sites[] = {
+                    {section::public_key, 0, "invalid proof of knowledge of tau"},
+                    {section::public_key, 1, "invalid proof of knowledge of alpha"},
+                    {section::public_key, 2, "invalid proof of knowledge of beta"},
+                    {section::tau_g1, 1, "not the challenge times tau"},
+                    {section::alpha_tau_g1, 0, "not the challenge times alpha"},
+                    {section::beta_tau_g1, 0, "not the challenge times beta"},
+                    {section::beta_g2, 0, "not the challenge times beta"},
+                };
+
+                std::vector<inconsistency> found;
+                // Powers missing or in excess leave nothing to compare them with.
+                auto count_powers = [&](section where, std::size_t expected, std::size_t count) {
+                    if (count != expected) {
+                        found.push_back({where, std::min(count, expected), std::max(count, expected) - 1,
+                                         "not as many powers as the challenge"});
+                    }
+                };
+                count_powers(section::tau_g1, before.tau_powers_g1.size(), after.tau_powers_g1.size());
+                count_powers(section::tau_g2, before.tau_powers_g2.size(), after.tau_powers_g2.size());
+                count_powers(section::alpha_tau_g1, before.alpha_tau_powers_g1.size(),
+                             after.alpha_tau_powers_g1.size());
+                count_powers(section::beta_tau_g1, before.beta_tau_powers_g1.size(), after.beta_tau_powers_g1.size());
+                if (found.empty() && !detail::well_formed(after)) {
+                    found.push_back({section::tau_g2, 0, 0, "not the powers of a ceremony"});
+                }
+                if (!found.empty()) {
+                    return found;
+                }
+
+                if (!(after.tau_powers_g1[0] == g1_value_type::one())) {
+                    found.push_back({section::tau_g1, 0, 0, "not the generator"});
+                }
+                if (!(after.tau_powers_g2[0] == g2_value_type::one())) {
+                    found.push_back({section::tau_g2, 0, 0, "not the generator"});
+                }
+
+                auto ratios = detail::point_claims<SchemeType>(public_key, before, after);
+                for (std::size_t i = 0; i < ratios.size(); ++i) {
+                    if (!detail::same_ratio<curve_type>(ratios[i].g1, ratios[i].g2)) {
+                        const claim_site &c = sites[i];
+                        found.push_back({c.where, c.index, c.index, c.reason});
+                    }
+                }
+
+                const g1_pair tau_g1 = {after.tau_powers_g1[0], after.tau_powers_g1[1]};
+                const g2_pair tau_g2 = {after.tau_powers_g2[0], after.tau_powers_g2[1]};
+
+                auto locate_pairs = [&](section where, const auto &v, task_cost cost, auto holds_ratio) {
+                    auto holds = [&](std::size_t first, std::size_t last) {
+                        return holds_ratio(detail::power_pairs<curve_type>(s, v, first, last, cost));
+                    };
+                    std::size_t pairs = v.size() - 1, failing_pairs = 0;
+                    std::vector<std::pair<std::size_t, std::size_t>> failing;
+                    if (!holds(0, pairs)) {
+                        detail::bisect(0, pairs, holds, limit, failing_pairs, failing);
+                    }
+                    // The run of pairs [first, last) spans the powers first to last.
+                    for (const auto &run : failing) {
+                        found.push_back({where, run.first, run.second, "not consecutive powers of tau"});
+                    }
+                };
+                auto with_g2_powers = [&](const g1_pair &pairs) {
+                    return detail::same_ratio<curve_type>(pairs, tau_g2);
+                };
+                locate_pairs(section::tau_g1, after.tau_powers_g1, task_cost::g1, with_g2_powers);
+                locate_pairs(section::tau_g2, after.tau_powers_g2, task_cost::g2, [&](const g2_pair &pairs) {
+                    return detail::same_ratio<curve_type>(tau_g1, pairs);
+                });
+                locate_pairs(section::alpha_tau_g1, after.alpha_tau_powers_g1, task_cost::g1, with_g2_powers);
+                locate_pairs(section::beta_tau_g1, after.beta_tau_powers_g1, task_cost::g1, with_g2_powers);
+                return found;
+            }
+        }    // namespace cli
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CLI_VERIFY_HPP
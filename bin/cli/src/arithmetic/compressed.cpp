@@ -0,0 +1,286 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <nil/crypto3/cli/arithmetic/compressed.hpp>
+#include <nil/crypto3/cli/arithmetic/fp381.hpp>
+#include <nil/crypto3/cli/arithmetic/tower.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+                namespace {
+                    // Encoded points are the public transcript, so decoding may take time depending on them.
+                    using fp = fp381_vartime;
+                    using fp2 = fp2_tower_ops<fp>;
+                    using fp2_type = fp2::value_type;
+                    using integer = std::array<std::uint64_t, 6>;
+
+                    static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "words are loaded in host order");
+
+                    constexpr std::size_t coordinate_size = 48;
+
+                    constexpr std::uint8_t compression_flag = 0x80;
+                    constexpr std::uint8_t infinity_flag = 0x40;
+                    constexpr std::uint8_t sign_flag = 0x20;
+                    constexpr std::uint64_t flags_mask = std::uint64_t(0xe0) << 56;
+
+                    /// (p + delta) / 2^shift, for a delta small enough not to carry out of the low limb of p.
+                    constexpr integer modulus_fraction(std::int64_t delta, std::size_t shift) {
+                        integer a = fp381_params::modulus;
+                        a[0] += static_cast<std::uint64_t>(delta);
+                        for (std::size_t s = 0; s < shift; ++s) {
+                            for (std::size_t i = 0; i < 5; ++i) {
+                                a[i] = (a[i] >> 1) | (a[i + 1] << 63);
+                            }
+                            a[5] >>= 1;
+                        }
+                        return a;
+                    }
+
+                    constexpr integer p_plus_1_over_4 = modulus_fraction(1, 2);
+                    constexpr integer p_plus_1_over_2 = modulus_fraction(1, 1);
+                    constexpr integer p_minus_1_over_2 = modulus_fraction(-1, 1);
+
+                    template<typename Ops>
+                    typename Ops::value_type pow(const typename Ops::value_type &a, const integer &exponent) {
+                        typename Ops::value_type r = Ops::one();
+                        for (std::size_t i = 6; i-- > 0;) {
+                            for (std::size_t bit = 64; bit-- > 0;) {
+                                r = Ops::sqr(r);
+                                if ((exponent[i] >> bit) & 1) {
+                                    r = Ops::mul(r, a);
+                                }
+                            }
+                        }
+                        return r;
+                    }
+
+                    bool greater(const integer &a, const integer &b) {
+                        for (std::size_t i = 6; i-- > 0;) {
+                            if (a[i] != b[i]) {
+                                return a[i] > b[i];
+                            }
+                        }
+                        return false;
+                    }
+
+                    bool is_zero(const integer &a) {
+                        return !(a[0] | a[1] | a[2] | a[3] | a[4] | a[5]);
+                    }
+
+                    bool equal(const fp381 &a, const fp381 &b) {
+                        return a.limbs == b.limbs;
+                    }
+
+                    bool equal(const fp2_type &a, const fp2_type &b) {
+                        return equal(a.c0, b.c0) && equal(a.c1, b.c1);
+                    }
+
+                    /// y > -y as integers, which the sign flag records.
+                    bool is_larger_root(const fp381 &y) {
+                        return greater(from_montgomery(y), p_minus_1_over_2);
+                    }
+
+                    bool is_larger_root(const fp2_type &y) {
+                        return fp::is_zero(y.c1) ? is_larger_root(y.c0) : is_larger_root(y.c1);
+                    }
+
+                    /// y with y^2 = a, p = 3 mod 4.
+                    bool sqrt(const fp381 &a, fp381 &y) {
+                        y = pow<fp>(a, p_plus_1_over_4);
+                        return equal(fp::sqr(y), a);
+                    }
+
+                    /**
+                     * y with y^2 = a in Fp2 = Fp[u] / (u^2 + 1) from two square roots in Fp (Scott 2012): with
+                     * alpha^2 = a0^2 + a1^2 the norm, y0^2 = (a0 +- alpha) / 2 for one of the signs and
+                     * y1 = a1 / 2 y0. Cheaper than an exponentiation in Fp2.
+                     */
+                    bool sqrt(const fp2_type &a, fp2_type &y) {
+                        const fp381 half = to_montgomery(p_plus_1_over_2);
+                        if (fp::is_zero(a.c1)) {
+                            // -1 is a non-residue, so either a0 or -a0 is a square.
+                            fp381 root;
+                            y = sqrt(a.c0, root) ? fp2_type {root, fp::zero()} :
+                                                   fp2_type {fp::zero(), pow<fp>(fp::neg(a.c0), p_plus_1_over_4)};
+                        } else {
+                            fp381 alpha, y0;
+                            if (!sqrt(fp::add(fp::sqr(a.c0), fp::sqr(a.c1)), alpha)) {
+                                return false;
+                            }
+                            // y0 = 0 would leave y1 undefined; a1 != 0 means the other sign then works.
+                            if ((!sqrt(fp::mul(fp::add(a.c0, alpha), half), y0) || fp::is_zero(y0)) &&
+                                !sqrt(fp::mul(fp::sub(a.c0, alpha), half), y0)) {
+                                return false;
+                            }
+                            y = {y0, fp::mul(fp::mul(a.c1, half), fp::inverse(y0))};
+                        }
+                        return equal(fp2::sqr(y), a);
+                    }
+
+                    std::uint64_t load_word(const std::uint8_t *in, byte_order order) {
+                        std::uint64_t word;
+                        std::memcpy(&word, in, sizeof(word));
+                        return order == byte_order::big_endian ? __builtin_bswap64(word) : word;
+                    }
+
+                    void store_word(std::uint64_t word, std::uint8_t *out, byte_order order) {
+                        word = order == byte_order::big_endian ? __builtin_bswap64(word) : word;
+                        std::memcpy(out, &word, sizeof(word));
+                    }
+
+                    integer load_coordinate(const std::uint8_t *in, byte_order order) {
+                        integer a;
+                        for (std::size_t i = 0; i < 6; ++i) {
+                            a[i] = load_word(in + 8 * (order == byte_order::big_endian ? 5 - i : i), order);
+                        }
+                        return a;
+                    }
+
+                    void store_coordinate(const integer &a, std::uint8_t *out, byte_order order) {
+                        for (std::size_t i = 0; i < 6; ++i) {
+                            store_word(a[i], out + 8 * (order == byte_order::big_endian ? 5 - i : i), order);
+                        }
+                    }
+
+                    /// Splits the flags off the most significant coordinate.
+                    std::uint8_t take_flags(integer &a) {
+                        std::uint8_t flags = static_cast<std::uint8_t>((a[5] & flags_mask) >> 56);
+                        a[5] &= ~flags_mask;
+                        return flags;
+                    }
+
+                    bool below_modulus(const integer &a) {
+                        return greater(fp381_params::modulus, a);
+                    }
+
+                    /// Where the more and the less significant coordinate of a G2 record start.
+                    std::size_t high_offset(byte_order order) {
+                        return order == byte_order::big_endian ? 0 : coordinate_size;
+                    }
+
+                    std::size_t low_offset(byte_order order) {
+                        return order == byte_order::big_endian ? coordinate_size : 0;
+                    }
+
+                    std::uint8_t point_flags(bool infinity, bool larger_root) {
+                        return compression_flag | (infinity ? infinity_flag : 0) | (larger_root ? sign_flag : 0);
+                    }
+
+                    void encode(const g1_affine &p, std::uint8_t *out, byte_order order) {
+                        integer x = p.infinity ? integer {} : from_montgomery(p.x);
+                        x[5] |= std::uint64_t(point_flags(p.infinity, !p.infinity && is_larger_root(p.y))) << 56;
+                        store_coordinate(x, out, order);
+                    }
+
+                    void encode(const g2_affine &p, std::uint8_t *out, byte_order order) {
+                        integer x0 = p.infinity ? integer {} : from_montgomery(p.x.c0);
+                        integer x1 = p.infinity ? integer {} : from_montgomery(p.x.c1);
+                        bool larger_root = !p.infinity && is_larger_root(fp2_type {p.y.c0, p.y.c1});
+                        x1[5] |= std::uint64_t(point_flags(p.infinity, larger_root)) << 56;
+                        store_coordinate(x1, out + high_offset(order), order);
+                        store_coordinate(x0, out + low_offset(order), order);
+                    }
+
+                    bool decode(const std::uint8_t *in, g1_affine &p, byte_order order) {
+                        integer x = load_coordinate(in, order);
+                        std::uint8_t flags = take_flags(x);
+                        if (!(flags & compression_flag)) {
+                            return false;
+                        }
+                        if (flags & infinity_flag) {
+                            p = {fp::zero(), fp::zero(), true};
+                            return !(flags & sign_flag) && is_zero(x);
+                        }
+                        if (!below_modulus(x)) {
+                            return false;
+                        }
+                        // y^2 = x^3 + 4
+                        p.x = to_montgomery(x);
+                        p.infinity = false;
+                        fp381 rhs = fp::add(fp::mul(fp::sqr(p.x), p.x), to_montgomery({4, 0, 0, 0, 0, 0}));
+                        if (!sqrt(rhs, p.y)) {
+                            return false;
+                        }
+                        if (is_larger_root(p.y) != bool(flags & sign_flag)) {
+                            p.y = fp::neg(p.y);
+                        }
+                        return true;
+                    }
+
+                    bool decode(const std::uint8_t *in, g2_affine &p, byte_order order) {
+                        integer x1 = load_coordinate(in + high_offset(order), order);
+                        integer x0 = load_coordinate(in + low_offset(order), order);
+                        std::uint8_t flags = take_flags(x1);
+                        if (!(flags & compression_flag)) {
+                            return false;
+                        }
+                        if (flags & infinity_flag) {
+                            p = {{fp::zero(), fp::zero()}, {fp::zero(), fp::zero()}, true};
+                            return !(flags & sign_flag) && is_zero(x0) && is_zero(x1);
+                        }
+                        if (!below_modulus(x0) || !below_modulus(x1)) {
+                            return false;
+                        }
+                        // y^2 = x^3 + 4 (u + 1)
+                        fp2_type x = {to_montgomery(x0), to_montgomery(x1)};
+                        fp381 four = to_montgomery({4, 0, 0, 0, 0, 0});
+                        fp2_type rhs = fp2::add(fp2::mul(fp2::sqr(x), x), fp2_type {four, four});
+                        fp2_type y;
+                        if (!sqrt(rhs, y)) {
+                            return false;
+                        }
+                        if (is_larger_root(y) != bool(flags & sign_flag)) {
+                            y = fp2::neg(y);
+                        }
+                        p = {{x.c0, x.c1}, {y.c0, y.c1}, false};
+                        return true;
+                    }
+                }    // namespace
+
+                void encode_compressed(const g1_affine *points, std::size_t count, std::uint8_t *out,
+                                       byte_order order) {
+                    for (std::size_t i = 0; i < count; ++i) {
+                        encode(points[i], out + i * g1_compressed_size, order);
+                    }
+                }
+
+                void encode_compressed(const g2_affine *points, std::size_t count, std::uint8_t *out,
+                                       byte_order order) {
+                    for (std::size_t i = 0; i < count; ++i) {
+                        encode(points[i], out + i * g2_compressed_size, order);
+                    }
+                }
+
+                bool decode_compressed(const std::uint8_t *in, std::size_t count, g1_affine *points,
+                                       byte_order order) {
+                    for (std::size_t i = 0; i < count; ++i) {
+                        if (!decode(in + i * g1_compressed_size, points[i], order)) {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+
+                bool decode_compressed(const std::uint8_t *in, std::size_t count, g2_affine *points,
+                                       byte_order order) {
+                    for (std::size_t i = 0; i < count; ++i) {
+                        if (!decode(in + i * g2_compressed_size, points[i], order)) {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
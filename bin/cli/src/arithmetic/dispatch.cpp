@@ -0,0 +1,274 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <cpuid.h>
+#endif
+
+#include <nil/crypto3/cli/arithmetic/fp381.hpp>
+#include <nil/crypto3/cli/arithmetic/kernels.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+                namespace {
+                    using limbs_type = std::array<std::uint64_t, 6>;
+
+                    // The generators, and their multiples by the self-test scalar, in affine coordinates.
+                    constexpr limbs_type g1_x = {0xfb3af00adb22c6bb, 0x6c55e83ff97a1aef, 0xa14e3a3f171bac58,
+                                                 0xc3688c4f9774b905, 0x2695638c4fa9ac0f, 0x17f1d3a73197d794};
+                    constexpr limbs_type g1_y = {0x0caa232946c5e7e1, 0xd03cc744a2888ae4, 0x00db18cb2c04b3ed,
+                                                 0xfcf5e095d5d00af6, 0xa09e30ed741d8ae4, 0x08b3f481e3aaa0f1};
+                    constexpr limbs_type g2_x0 = {0xd48056c8c121bdb8, 0x0bac0326a805bbef, 0xb4510b647ae3d177,
+                                                  0xc6e47ad4fa403b02, 0x260805272dc51051, 0x024aa2b2f08f0a91};
+                    constexpr limbs_type g2_x1 = {0xe5ac7d055d042b7e, 0x334cf11213945d57, 0xb5da61bbdc7f5049,
+                                                  0x596bd0d09920b61a, 0x7dacd3a088274f65, 0x13e02b6052719f60};
+                    constexpr limbs_type g2_y0 = {0xe193548608b82801, 0x923ac9cc3baca289, 0x6d429a695160d12c,
+                                                  0xadfd9baa8cbdd3a7, 0x8cc9cdc6da2e351a, 0x0ce5d527727d6e11};
+                    constexpr limbs_type g2_y1 = {0xaaa9075ff05f79be, 0x3f370d275cec1da1, 0x267492ab572e99ab,
+                                                  0xcb3e287e85a763af, 0x32acd2b02bc28b99, 0x0606c4a02ea734cc};
+
+                    /// SHA-256("powers of tau kernel self-test") >> 2
+                    constexpr scalar256 test_scalar = {
+                        {0x21397e00be2ba1cf, 0x138ac0ff811c2bdd, 0xa254f70849108cda, 0x277f10ae02533420}};
+
+                    constexpr limbs_type kg1_x = {0x4802123742f82dc1, 0x885df676bde29114, 0x8bfb42606928d837,
+                                                  0x1f86d9e6cac41e2f, 0xe5b5850bf29cde9b, 0x03e48008ab645a21};
+                    constexpr limbs_type kg1_y = {0xff01fa6a4aa404c6, 0x293c95e59a18b3ad, 0xe77ae388309c7be8,
+                                                  0xf0dd17cd0ec555c9, 0xb69e06afb384866c, 0x0549390a7397823b};
+                    constexpr limbs_type kg2_x0 = {0x09a71a3c3a43edf7, 0xdb881525c78ec72f, 0xdc1a63406b86fa63,
+                                                   0x85054c27147e014e, 0x9bfb51e4e277ffda, 0x012d6738dd3b3c92};
+                    constexpr limbs_type kg2_x1 = {0xa6153cbbc8ae4267, 0x577f51c0e3d9fb54, 0x3876d50fd0eff609,
+                                                   0xae19a04ebdc49d7f, 0xfe82d7bc05dc7f50, 0x01ede46195afdbf1};
+                    constexpr limbs_type kg2_y0 = {0xfe7506368f2a5ea3, 0x6a3b214d55d51677, 0x1fae135a52710374,
+                                                   0x597d8abacbda1ef8, 0xd70c33a0c73ab373, 0x0f958de642b798a7};
+                    constexpr limbs_type kg2_y1 = {0x46fc397dfd48e360, 0xdddc2af7803873b3, 0x8de974d71a78d073,
+                                                   0x8a8ed4644bb95f24, 0x92f24b01b60dee04, 0x168206278c6de80e};
+
+                    // Points on the curves outside the prime-order subgroups, with x = 4 on G1 and x = 2 on G2.
+                    constexpr limbs_type outside_g1_x = {4, 0, 0, 0, 0, 0};
+                    constexpr limbs_type outside_g1_y = {0x5ea93e354abe706c, 0x6346b8ed00e1de5d, 0xda9dd85e92848344,
+                                                         0xc760f988c9926b26, 0xb33cffc3f3763e9b, 0x0a989badd40d6212};
+                    constexpr limbs_type outside_g2_x0 = {2, 0, 0, 0, 0, 0};
+                    constexpr limbs_type outside_g2_y0 = {0x185b9a46a402be73, 0xdd387cfa9086b894, 0x42bc9a69cf9acdd9,
+                                                          0x0051a3c88899964a, 0xa4d9a3b6539246a7, 0x013a59858b6809fc};
+                    constexpr limbs_type outside_g2_y1 = {0xe32e03040c406d4f, 0x2082e5e58c6da24e, 0x9d2f929a3eecebf7,
+                                                          0x8a483c3aed53f913, 0xa346a09ad7dc4ef6, 0x02d27e0ec3356299};
+
+                    using base_ops = fp381_portable;
+                    using fp2_ops_type = fp2_ops<base_ops>;
+
+                    bool equal(const fp381 &a, const fp381 &b) {
+                        return a.limbs == b.limbs;
+                    }
+
+                    bool equal(const fp2_381 &a, const fp2_381 &b) {
+                        return equal(a.c0, b.c0) && equal(a.c1, b.c1);
+                    }
+
+                    fp381 scale(const fp381 &a, const fp381 &z) {
+                        return base_ops::mul(a, z);
+                    }
+
+                    fp2_381 scale(const fp2_381 &a, const fp2_381 &z) {
+                        auto r = fp2_ops_type::mul({a.c0, a.c1}, {z.c0, z.c1});
+                        return {r.c0, r.c1};
+                    }
+
+                    /// Homogeneous (X, Y, Z) is the affine (x, y) if X = x Z and Y = y Z with Z nonzero.
+                    template<typename RawType>
+                    bool represents(const RawType &p, const RawType &affine) {
+                        return equal(p.x, scale(affine.x, p.z)) && equal(p.y, scale(affine.y, p.z)) &&
+                               !equal(p.z, decltype(p.z) {});
+                    }
+
+                    /**
+                     * [k] P for more points than the widest backend has lanes, so a partial group is exercised
+                     * too, and the same product as the only nonzero term of a multi-scalar multiplication.
+                     */
+                    template<typename RawType, typename Multiply, typename MultiMultiply>
+                    bool check(Multiply multiply,
+                               MultiMultiply multi_multiply,
+                               const RawType &point,
+                               const RawType &expected,
+                               std::size_t count) {
+                        point_columns<RawType> points(count);
+                        for (std::size_t i = 0; i < count; ++i) {
+                            points[i] = point;
+                        }
+                        std::vector<scalar256> scalars(count, test_scalar);
+                        multiply(points, scalars.data());
+                        for (std::size_t i = 0; i < count; ++i) {
+                            if (!represents(points.get(i), expected)) {
+                                return false;
+                            }
+                        }
+                        const RawType terms[2] = {point, point};
+                        const scalar256 term_scalars[2] = {test_scalar, {}};
+                        return represents(multi_multiply(terms, term_scalars, 2), expected);
+                    }
+
+                    /**
+                     * Accepts multiples of a point in the subgroup and the identity, and locates a point outside the
+                     * subgroup and one off the curve among them, within and across groups of lanes.
+                     */
+                    template<typename RawType, typename Validate>
+                    bool check_validate(Validate validate,
+                                        const RawType &point,
+                                        const RawType &multiple,
+                                        const RawType &outside,
+                                        std::size_t count) {
+                        std::vector<RawType> points(count, multiple);
+                        points[0] = point;
+                        // (0 : Y : 0) is the identity for any nonzero Y.
+                        points[count / 2].x = {};
+                        points[count / 2].z = {};
+                        if (validate(points.data(), count) != count) {
+                            return false;
+                        }
+                        points[count - 2] = outside;
+                        if (validate(points.data(), count) != count - 2) {
+                            return false;
+                        }
+                        points[1].y = point.x;
+                        return validate(points.data(), count) == 1;
+                    }
+
+                    /// Accepts points on the curve, in the subgroup or not, and locates one off it.
+                    template<typename RawType, typename OnCurve>
+                    bool check_on_curve(OnCurve on_curve, const RawType &point, const RawType &outside,
+                                        std::size_t count) {
+                        std::vector<RawType> points(count, point);
+                        points[count / 2].x = {};
+                        points[count / 2].z = {};
+                        points[count - 2] = outside;
+                        if (on_curve(points.data(), count) != count) {
+                            return false;
+                        }
+                        points[count - 1].y = point.x;
+                        return on_curve(points.data(), count) == count - 1;
+                    }
+                }    // namespace
+
+                cpu_features detect_cpu_features() {
+                    cpu_features features;
+#if defined(__GNUC__) && defined(__x86_64__)
+                    unsigned eax, ebx, ecx, edx;
+                    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+                        return features;
+                    }
+                    // Vector registers are only usable if the OS saves them on context switches.
+                    bool ymm_state = false, zmm_state = false;
+                    if (ecx & bit_OSXSAVE) {
+                        unsigned xcr0_low, xcr0_high;
+                        __asm__("xgetbv" : "=a"(xcr0_low), "=d"(xcr0_high) : "c"(0));
+                        ymm_state = (xcr0_low & 0x06) == 0x06;
+                        zmm_state = (xcr0_low & 0xe6) == 0xe6;
+                    }
+                    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+                        return features;
+                    }
+                    features.bmi2 = ebx & bit_BMI2;
+                    features.adx = ebx & bit_ADX;
+                    features.avx2 = ymm_state && (ebx & bit_AVX2);
+                    features.avx512ifma =
+                        zmm_state && (ebx & bit_AVX512F) && (ebx & bit_AVX512VL) && (ebx & bit_AVX512IFMA);
+#endif
+                    return features;
+                }
+
+                g1_raw g1_generator() {
+                    return {to_montgomery(g1_x), to_montgomery(g1_y), base_ops::one()};
+                }
+
+                g2_raw g2_generator() {
+                    return {{to_montgomery(g2_x0), to_montgomery(g2_x1)},
+                            {to_montgomery(g2_y0), to_montgomery(g2_y1)},
+                            {base_ops::one(), base_ops::zero()}};
+                }
+
+                bool self_test(const kernel_table &table) {
+                    g1_raw g1 = g1_generator();
+                    g1_raw kg1 = {to_montgomery(kg1_x), to_montgomery(kg1_y), base_ops::one()};
+                    g2_raw g2 = g2_generator();
+                    g2_raw kg2 = {{to_montgomery(kg2_x0), to_montgomery(kg2_x1)},
+                                  {to_montgomery(kg2_y0), to_montgomery(kg2_y1)},
+                                  {base_ops::one(), base_ops::zero()}};
+
+                    g1_raw outside_g1 = {to_montgomery(outside_g1_x), to_montgomery(outside_g1_y), base_ops::one()};
+                    g2_raw outside_g2 = {{to_montgomery(outside_g2_x0), base_ops::zero()},
+                                         {to_montgomery(outside_g2_y0), to_montgomery(outside_g2_y1)},
+                                         {base_ops::one(), base_ops::zero()}};
+
+                    return check(table.g1_mul, table.g1_multi_mul, g1, kg1, 9) &&
+                           check(table.g2_mul, table.g2_multi_mul, g2, kg2, 9) &&
+                           check(table.g1_mul_vartime, table.g1_multi_mul_vartime, g1, kg1, 9) &&
+                           check(table.g2_mul_vartime, table.g2_multi_mul_vartime, g2, kg2, 9) &&
+                           check_validate(table.g1_validate, g1, kg1, outside_g1, 9) &&
+                           check_validate(table.g2_validate, g2, kg2, outside_g2, 9) &&
+                           check_on_curve(table.g1_on_curve, kg1, outside_g1, 9) &&
+                           check_on_curve(table.g2_on_curve, kg2, outside_g2, 9);
+                }
+
+                const kernel_dispatch &dispatch() {
+                    static const kernel_dispatch selection = [] {
+                        struct backend {
+                            const kernel_table *table;
+                            bool (*supported)(const cpu_features &);
+                        };
+                        const backend backends[] = {
+#if defined(CRYPTO3_CLI_HAS_AVX512IFMA)
+                            {&avx512ifma_kernels, [](const cpu_features &f) { return f.avx512ifma; }},
+#endif
+#if defined(CRYPTO3_CLI_HAS_MULX)
+                            {&mulx_kernels, [](const cpu_features &f) { return f.bmi2 && f.adx; }},
+#endif
+#if defined(CRYPTO3_CLI_HAS_AVX2)
+                            {&avx2_kernels, [](const cpu_features &f) { return f.avx2; }},
+#endif
+#if defined(CRYPTO3_CLI_HAS_AARCH64)
+                            {&aarch64_kernels, [](const cpu_features &) { return true; }},
+#endif
+                            {&portable_kernels, [](const cpu_features &) { return true; }},
+                        };
+
+                        kernel_dispatch d;
+                        d.features = detect_cpu_features();
+                        d.selected = nullptr;
+                        for (const backend &b : backends) {
+                            kernel_dispatch::status result = kernel_dispatch::status::unsupported;
+                            if (d.selected) {
+                                result = b.supported(d.features) ? kernel_dispatch::status::untested : result;
+                            } else if (b.supported(d.features)) {
+                                result = self_test(*b.table) ? kernel_dispatch::status::passed :
+                                                               kernel_dispatch::status::failed;
+                                if (result == kernel_dispatch::status::passed) {
+                                    d.selected = b.table;
+                                }
+                            }
+                            d.candidates.push_back({b.table, result});
+                        }
+                        if (!d.selected) {
+                            throw std::runtime_error("no arithmetic backend passed its self-test");
+                        }
+                        return d;
+                    }();
+                    return selection;
+                }
+
+                const kernel_table &kernels() {
+                    return *dispatch().selected;
+                }
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
@@ -0,0 +1,18 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#include <nil/crypto3/cli/arithmetic/batch.hpp>
+#include <nil/crypto3/cli/arithmetic/kernels.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+                constexpr kernel_table portable_kernels = make_kernel_table<fp381_portable>("portable");
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
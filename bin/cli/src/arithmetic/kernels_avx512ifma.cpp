@@ -0,0 +1,20 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+// Compiled with AVX-512 F, VL and IFMA enabled; nothing here may run before kernels() has checked the CPU.
+
+#include <nil/crypto3/cli/arithmetic/batch.hpp>
+#include <nil/crypto3/cli/arithmetic/fp381_avx512ifma.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+                constexpr kernel_table avx512ifma_kernels = make_kernel_table<fp381_avx512ifma>("avx512ifma");
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
@@ -0,0 +1,20 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+// Calls into assembly using BMI2 and ADX; nothing here may run before kernels() has checked the CPU.
+
+#include <nil/crypto3/cli/arithmetic/batch.hpp>
+#include <nil/crypto3/cli/arithmetic/fp381_mulx.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+                constexpr kernel_table mulx_kernels = make_kernel_table<fp381_mulx>("mulx");
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
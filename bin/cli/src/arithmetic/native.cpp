@@ -0,0 +1,195 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <nil/crypto3/cli/arithmetic/fp381.hpp>
+#include <nil/crypto3/cli/arithmetic/native.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+                namespace {
+                    using integer = std::array<std::uint64_t, 6>;
+
+                    constexpr std::size_t coordinate_size = 48;
+
+                    /// Bumped whenever the records change meaning.
+                    constexpr std::uint64_t native_format_version = 1;
+
+                    static_assert(sizeof(fp381) == coordinate_size, "fp381 is six limbs without padding");
+
+                    /// FNV-1a, folding bytes into h.
+                    void fingerprint_bytes(std::uint64_t &h, const void *p, std::size_t length) {
+                        const auto *bytes = static_cast<const std::uint8_t *>(p);
+                        for (std::size_t i = 0; i < length; ++i) {
+                            h = (h ^ bytes[i]) * 0x100000001b3;
+                        }
+                    }
+
+                    /**
+                     * Hashes the version and the bytes of one and of R = 2^384 mod p in Montgomery form, R mod p and
+                     * R^2 mod p, as an encoding lays them out: it tells apart builds differing in radix, limb order
+                     * or byte order.
+                     */
+                    std::uint64_t fingerprint_of(const std::uint8_t *one, const std::uint8_t *r) {
+                        std::uint64_t h = 0xcbf29ce484222325;
+                        std::array<std::uint8_t, 8> version;
+                        for (std::size_t i = 0; i < version.size(); ++i) {
+                            version[i] = static_cast<std::uint8_t>(native_format_version >> (8 * i));
+                        }
+                        fingerprint_bytes(h, version.data(), version.size());
+                        fingerprint_bytes(h, one, coordinate_size);
+                        fingerprint_bytes(h, r, coordinate_size);
+                        return h;
+                    }
+
+                    std::array<std::uint8_t, coordinate_size> little_endian(const integer &a) {
+                        std::array<std::uint8_t, coordinate_size> bytes;
+                        for (std::size_t i = 0; i < coordinate_size; ++i) {
+                            bytes[i] = static_cast<std::uint8_t>(a[i / 8] >> (8 * (i % 8)));
+                        }
+                        return bytes;
+                    }
+
+                    bool below_modulus(const integer &a) {
+                        for (std::size_t i = 6; i-- > 0;) {
+                            if (a[i] != fp381_params::modulus[i]) {
+                                return a[i] < fp381_params::modulus[i];
+                            }
+                        }
+                        return false;
+                    }
+
+                    bool is_zero(const fp381 &a) {
+                        return !(a.limbs[0] | a.limbs[1] | a.limbs[2] | a.limbs[3] | a.limbs[4] | a.limbs[5]);
+                    }
+
+                    void store_coordinate(const fp381 &a, std::uint8_t *&out) {
+                        std::memcpy(out, a.limbs.data(), coordinate_size);
+                        out += coordinate_size;
+                    }
+
+                    /// The limbs as this build holds them, which the fingerprint vouches for.
+                    bool copy_coordinate(const std::uint8_t *&in, fp381 &a) {
+                        std::memcpy(a.limbs.data(), in, coordinate_size);
+                        in += coordinate_size;
+                        return below_modulus(a.limbs);
+                    }
+
+                    /// The limbs as the reference layout has them: little-endian, a R with R = 2^384.
+                    bool read_coordinate(const std::uint8_t *&in, fp381 &a) {
+                        integer value {};
+                        for (std::size_t i = 0; i < 6; ++i) {
+                            for (std::size_t j = 8; j-- > 0;) {
+                                value[i] = (value[i] << 8) | in[8 * i + j];
+                            }
+                        }
+                        in += coordinate_size;
+                        if (!below_modulus(value)) {
+                            return false;
+                        }
+                        // Out of the reference Montgomery form and into this build's.
+                        a = to_montgomery(fp381_portable::mul({value}, {{1, 0, 0, 0, 0, 0}}).limbs);
+                        return true;
+                    }
+
+                    bool load_coordinate(const std::uint8_t *&in, fp381 &a, bool same_build) {
+                        return same_build ? copy_coordinate(in, a) : read_coordinate(in, a);
+                    }
+
+                    void store(const g1_affine &p, std::uint8_t *out) {
+                        if (p.infinity) {
+                            std::memset(out, 0, g1_native_size);
+                            return;
+                        }
+                        store_coordinate(p.x, out);
+                        store_coordinate(p.y, out);
+                    }
+
+                    void store(const g2_affine &p, std::uint8_t *out) {
+                        if (p.infinity) {
+                            std::memset(out, 0, g2_native_size);
+                            return;
+                        }
+                        store_coordinate(p.x.c0, out);
+                        store_coordinate(p.x.c1, out);
+                        store_coordinate(p.y.c0, out);
+                        store_coordinate(p.y.c1, out);
+                    }
+
+                    bool load(const std::uint8_t *in, g1_affine &p, bool same_build) {
+                        if (!load_coordinate(in, p.x, same_build) || !load_coordinate(in, p.y, same_build)) {
+                            return false;
+                        }
+                        p.infinity = is_zero(p.x) && is_zero(p.y);
+                        return true;
+                    }
+
+                    bool load(const std::uint8_t *in, g2_affine &p, bool same_build) {
+                        if (!load_coordinate(in, p.x.c0, same_build) || !load_coordinate(in, p.x.c1, same_build) ||
+                            !load_coordinate(in, p.y.c0, same_build) || !load_coordinate(in, p.y.c1, same_build)) {
+                            return false;
+                        }
+                        p.infinity = is_zero(p.x.c0) && is_zero(p.x.c1) && is_zero(p.y.c0) && is_zero(p.y.c1);
+                        return true;
+                    }
+                }    // namespace
+
+                std::uint64_t native_fingerprint() {
+                    static const std::uint64_t fingerprint = [] {
+                        const fp381 one = fp381_portable::one(), r = to_montgomery(fp381_params::one);
+                        return fingerprint_of(reinterpret_cast<const std::uint8_t *>(one.limbs.data()),
+                                              reinterpret_cast<const std::uint8_t *>(r.limbs.data()));
+                    }();
+                    return fingerprint;
+                }
+
+                bool native_readable(std::uint64_t fingerprint) {
+                    // Computed on integers, so it doesn't depend on how this build holds fp381.
+                    static const std::uint64_t reference =
+                        fingerprint_of(little_endian(detail::montgomery_one(fp381_params::modulus)).data(),
+                                       little_endian(detail::montgomery_r2(fp381_params::modulus)).data());
+                    return fingerprint == native_fingerprint() || fingerprint == reference;
+                }
+
+                void store_native(const g1_affine *points, std::size_t count, std::uint8_t *out) {
+                    for (std::size_t i = 0; i < count; ++i) {
+                        store(points[i], out + i * g1_native_size);
+                    }
+                }
+
+                void store_native(const g2_affine *points, std::size_t count, std::uint8_t *out) {
+                    for (std::size_t i = 0; i < count; ++i) {
+                        store(points[i], out + i * g2_native_size);
+                    }
+                }
+
+                bool load_native(const std::uint8_t *in, std::size_t count, g1_affine *points, bool same_build) {
+                    for (std::size_t i = 0; i < count; ++i) {
+                        if (!load(in + i * g1_native_size, points[i], same_build)) {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+
+                bool load_native(const std::uint8_t *in, std::size_t count, g2_affine *points, bool same_build) {
+                    for (std::size_t i = 0; i < count; ++i) {
+                        if (!load(in + i * g2_native_size, points[i], same_build)) {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
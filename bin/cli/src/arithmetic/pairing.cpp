@@ -0,0 +1,441 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <nil/crypto3/cli/arithmetic/fp381.hpp>
+#include <nil/crypto3/cli/arithmetic/kernels.hpp>
+#include <nil/crypto3/cli/arithmetic/pairing.hpp>
+#include <nil/crypto3/cli/arithmetic/tower.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace cli {
+            namespace arithmetic {
+                namespace {
+                    // Everything paired is public: the points of the transcript and their random combinations.
+                    using fp = fp381_vartime;
+                    using fp2 = fp2_tower_ops<fp>;
+                    using fp2_type = fp2::value_type;
+                    using fp12 = fp12_ops<fp>;
+                    using fp12_type = fp12::value_type;
+
+                    /// |u|, the Miller loop length; u itself is negative.
+                    constexpr std::uint64_t u_abs = 0xd201000000010000;
+
+                    /// Where timed results go, so that the timed loops aren't optimized away.
+                    volatile std::uint64_t timing_sink;
+
+                    fp2_type load(const fp2_381 &a) {
+                        return {a.c0, a.c1};
+                    }
+
+                    fp2_381 store(const fp2_type &a) {
+                        return {a.c0, a.c1};
+                    }
+
+                    /// Coefficients of a line through the running point, evaluated at P by ell().
+                    struct line {
+                        fp2_type c0;
+                        fp2_type c1;
+                        fp2_type c2;
+                    };
+
+                    /// The running multiple of Q in Jacobian coordinates (X / Z^2, Y / Z^3).
+                    struct g2_jacobian {
+                        fp2_type x;
+                        fp2_type y;
+                        fp2_type z;
+                    };
+
+                    /// Tangent at R, and R = 2 R (Costello, Lange, Naehrig 2010, algorithm 26).
+                    line doubling_step(g2_jacobian &r) {
+                        fp2_type t0 = fp2::sqr(r.x);
+                        fp2_type t1 = fp2::sqr(r.y);
+                        fp2_type t2 = fp2::sqr(t1);
+                        fp2_type t3 = fp2::sub(fp2::sub(fp2::sqr(fp2::add(t1, r.x)), t0), t2);
+                        t3 = fp2::add(t3, t3);
+                        fp2_type t4 = fp2::add(fp2::add(t0, t0), t0);
+                        fp2_type t6 = fp2::add(r.x, t4);
+                        fp2_type t5 = fp2::sqr(t4);
+                        fp2_type zz = fp2::sqr(r.z);
+                        r.x = fp2::sub(fp2::sub(t5, t3), t3);
+                        r.z = fp2::sub(fp2::sub(fp2::sqr(fp2::add(r.z, r.y)), t1), zz);
+                        r.y = fp2::mul(fp2::sub(t3, r.x), t4);
+                        t2 = fp2::add(t2, t2);
+                        t2 = fp2::add(t2, t2);
+                        t2 = fp2::add(t2, t2);
+                        r.y = fp2::sub(r.y, t2);
+                        t3 = fp2::mul(t4, zz);
+                        t3 = fp2::neg(fp2::add(t3, t3));
+                        t6 = fp2::sub(fp2::sub(fp2::sqr(t6), t0), t5);
+                        t1 = fp2::add(t1, t1);
+                        t1 = fp2::add(t1, t1);
+                        t6 = fp2::sub(t6, t1);
+                        t0 = fp2::mul(r.z, zz);
+                        t0 = fp2::add(t0, t0);
+                        return {t0, t3, t6};
+                    }
+
+                    /// Line through R and Q, and R = R + Q (Costello, Lange, Naehrig 2010, algorithm 27).
+                    line addition_step(g2_jacobian &r, const fp2_type &qx, const fp2_type &qy) {
+                        fp2_type zz = fp2::sqr(r.z);
+                        fp2_type yy = fp2::sqr(qy);
+                        fp2_type t0 = fp2::mul(zz, qx);
+                        fp2_type t1 = fp2::mul(fp2::sub(fp2::sub(fp2::sqr(fp2::add(qy, r.z)), yy), zz), zz);
+                        fp2_type t2 = fp2::sub(t0, r.x);
+                        fp2_type t3 = fp2::sqr(t2);
+                        fp2_type t4 = fp2::add(t3, t3);
+                        t4 = fp2::add(t4, t4);
+                        fp2_type t5 = fp2::mul(t4, t2);
+                        fp2_type t6 = fp2::sub(fp2::sub(t1, r.y), r.y);
+                        fp2_type t9 = fp2::mul(t6, qx);
+                        fp2_type t7 = fp2::mul(t4, r.x);
+                        r.x = fp2::sub(fp2::sub(fp2::sub(fp2::sqr(t6), t5), t7), t7);
+                        r.z = fp2::sub(fp2::sub(fp2::sqr(fp2::add(r.z, t2)), zz), t3);
+                        fp2_type t10 = fp2::add(qy, r.z);
+                        fp2_type t8 = fp2::mul(fp2::sub(t7, r.x), t6);
+                        t0 = fp2::mul(r.y, t5);
+                        t0 = fp2::add(t0, t0);
+                        r.y = fp2::sub(t8, t0);
+                        t10 = fp2::sub(fp2::sub(fp2::sqr(t10), yy), fp2::sqr(r.z));
+                        t9 = fp2::sub(fp2::add(t9, t9), t10);
+                        t10 = fp2::add(r.z, r.z);
+                        t6 = fp2::neg(t6);
+                        t1 = fp2::add(t6, t6);
+                        return {t10, t1, t9};
+                    }
+
+                    /// Multiplies f by the line evaluated at P, a sparse element of Fp12.
+                    fp12_type ell(const fp12_type &f, const line &l, const g1_affine &p) {
+                        fp2_type c0 = {fp::mul(l.c0.c0, p.y), fp::mul(l.c0.c1, p.y)};
+                        fp2_type c1 = {fp::mul(l.c1.c0, p.x), fp::mul(l.c1.c1, p.x)};
+                        return fp12::mul_by_014(f, l.c2, c1, c0);
+                    }
+
+                    /**
+                     * Double-and-add over the bits of |u| below the leading one: step(j, addition) takes the
+                     * next doubling or addition line of pair j, square() the squaring of the accumulator shared
+                     * by all pairs. The last bit of |u| is zero, so the loop ends in a doubling.
+                     */
+                    template<typename Step, typename Square>
+                    void walk_miller_loop(std::size_t count, Step step, Square square) {
+                        for (std::size_t bit = 62; bit-- > 0;) {
+                            for (std::size_t j = 0; j < count; ++j) {
+                                step(j, false);
+                            }
+                            if ((u_abs >> (bit + 1)) & 1) {
+                                for (std::size_t j = 0; j < count; ++j) {
+                                    step(j, true);
+                                }
+                            }
+                            square();
+                        }
+                        for (std::size_t j = 0; j < count; ++j) {
+                            step(j, false);
+                        }
+                    }
+
+                    /// Product of the Miller loops, lines(j, addition) yielding the lines of pair j; conjugated
+                    /// for the negative u.
+                    template<typename Lines>
+                    fp12_381 miller_loop(const std::vector<const g1_affine *> &p, Lines lines) {
+                        fp12_type f = fp12::one();
+                        walk_miller_loop(
+                            p.size(), [&](std::size_t j, bool addition) { f = ell(f, lines(j, addition), *p[j]); },
+                            [&]() { f = fp12::sqr(f); });
+                        return fp12::store(fp12::conjugate(f));
+                    }
+
+                    /**
+                     * f^u for f in the cyclotomic subgroup. The 63 squarings run on Karabina's compressed form,
+                     * and the six powers f^(2^k) for the set bits k of |u|, which is even, are decompressed
+                     * together with one inversion before they are multiplied.
+                     */
+                    fp12_type cyclotomic_exp_by_u(const fp12_type &f) {
+                        std::vector<fp12::compressed_type> powers;
+                        fp12::compressed_type c = fp12::compress(f);
+                        for (std::size_t bit = 1; bit < 64; ++bit) {
+                            c = fp12::compressed_sqr(c);
+                            if ((u_abs >> bit) & 1) {
+                                powers.push_back(c);
+                            }
+                        }
+
+                        std::vector<fp12_type> decompressed(powers.size());
+                        fp12_type r;
+                        if (fp12::decompress(powers.data(), decompressed.data(), powers.size())) {
+                            r = decompressed[0];
+                            for (std::size_t i = 1; i < decompressed.size(); ++i) {
+                                r = fp12::mul(r, decompressed[i]);
+                            }
+                        } else {
+                            // Degenerate inputs such as one, which compress to zero.
+                            r = f;
+                            for (std::size_t bit = 63; bit-- > 0;) {
+                                r = fp12::cyclotomic_sqr(r);
+                                if ((u_abs >> bit) & 1) {
+                                    r = fp12::mul(r, f);
+                                }
+                            }
+                        }
+                        // u < 0, and conjugation inverts in the cyclotomic subgroup.
+                        return fp12::conjugate(r);
+                    }
+
+                    fp12_type frobenius(fp12_type f, std::size_t power) {
+                        for (std::size_t i = 0; i < power; ++i) {
+                            f = fp12::frobenius(f);
+                        }
+                        return f;
+                    }
+
+                    bool is_zero(const fp381 &a) {
+                        return fp::is_zero(a);
+                    }
+
+                    bool is_zero(const fp2_type &a) {
+                        return fp::is_zero(a.c0) & fp::is_zero(a.c1);
+                    }
+
+                    fp381 mul(const fp381 &a, const fp381 &b) {
+                        return fp::mul(a, b);
+                    }
+
+                    fp2_type mul(const fp2_type &a, const fp2_type &b) {
+                        return fp2::mul(a, b);
+                    }
+
+                    fp381 inverse(const fp381 &a) {
+                        return fp::inverse(a);
+                    }
+
+                    /// 1 / (a0 + a1 u) = (a0 - a1 u) / (a0^2 + a1^2)
+                    fp2_type inverse(const fp2_type &a) {
+                        fp381 norm_inverse = fp::inverse(fp::add(fp::sqr(a.c0), fp::sqr(a.c1)));
+                        return {fp::mul(a.c0, norm_inverse), fp::neg(fp::mul(a.c1, norm_inverse))};
+                    }
+
+                    /// Inverts every nonzero element with a single inversion (Montgomery's trick); zeros stay.
+                    template<typename ValueType>
+                    void invert_all(std::vector<ValueType> &a, const ValueType &one) {
+                        std::vector<ValueType> prefix(a.size());
+                        ValueType product = one;
+                        for (std::size_t i = 0; i < a.size(); ++i) {
+                            prefix[i] = product;
+                            if (!is_zero(a[i])) {
+                                product = mul(product, a[i]);
+                            }
+                        }
+                        ValueType product_inverse = inverse(product);
+                        for (std::size_t i = a.size(); i-- > 0;) {
+                            if (!is_zero(a[i])) {
+                                ValueType a_inverse = mul(product_inverse, prefix[i]);
+                                product_inverse = mul(product_inverse, a[i]);
+                                a[i] = a_inverse;
+                            }
+                        }
+                    }
+                }    // namespace
+
+                g1_affine to_affine(const g1_raw &p) {
+                    if (fp::is_zero(p.z)) {
+                        return {fp::zero(), fp::zero(), true};
+                    }
+                    fp381 z_inverse = fp::inverse(p.z);
+                    return {fp::mul(p.x, z_inverse), fp::mul(p.y, z_inverse), false};
+                }
+
+                g2_affine to_affine(const g2_raw &q) {
+                    if (is_zero(load(q.z))) {
+                        return {{fp::zero(), fp::zero()}, {fp::zero(), fp::zero()}, true};
+                    }
+                    fp2_type z_inverse = inverse(load(q.z));
+                    return {store(fp2::mul(load(q.x), z_inverse)), store(fp2::mul(load(q.y), z_inverse)), false};
+                }
+
+                void to_affine(const g1_raw *p, g1_affine *affine, std::size_t count) {
+                    std::vector<fp381> z_inverse(count);
+                    for (std::size_t i = 0; i < count; ++i) {
+                        z_inverse[i] = p[i].z;
+                    }
+                    invert_all(z_inverse, fp::one());
+                    for (std::size_t i = 0; i < count; ++i) {
+                        affine[i] = is_zero(p[i].z) ?
+                                        g1_affine {fp::zero(), fp::zero(), true} :
+                                        g1_affine {fp::mul(p[i].x, z_inverse[i]), fp::mul(p[i].y, z_inverse[i]), false};
+                    }
+                }
+
+                void to_affine(const g2_raw *q, g2_affine *affine, std::size_t count) {
+                    std::vector<fp2_type> z_inverse(count);
+                    for (std::size_t i = 0; i < count; ++i) {
+                        z_inverse[i] = load(q[i].z);
+                    }
+                    invert_all(z_inverse, fp2::one());
+                    for (std::size_t i = 0; i < count; ++i) {
+                        if (is_zero(load(q[i].z))) {
+                            affine[i] = {{fp::zero(), fp::zero()}, {fp::zero(), fp::zero()}, true};
+                        } else {
+                            affine[i] = {store(fp2::mul(load(q[i].x), z_inverse[i])),
+                                         store(fp2::mul(load(q[i].y), z_inverse[i])), false};
+                        }
+                    }
+                }
+
+                g2_prepared prepare(const g2_affine &q) {
+                    g2_prepared prepared {{}, q.infinity};
+                    if (q.infinity) {
+                        return prepared;
+                    }
+                    g2_jacobian r = {load(q.x), load(q.y), fp2::one()};
+                    walk_miller_loop(
+                        1,
+                        [&](std::size_t, bool addition) {
+                            line l = addition ? addition_step(r, load(q.x), load(q.y)) : doubling_step(r);
+                            prepared.lines.push_back({store(l.c0), store(l.c1), store(l.c2)});
+                        },
+                        []() {});
+                    return prepared;
+                }
+
+                fp12_381 multi_miller_loop(const g1_affine *p, const g2_affine *q, std::size_t count) {
+                    std::vector<const g1_affine *> pairs;
+                    std::vector<const g2_affine *> q_pairs;
+                    std::vector<g2_jacobian> r;
+                    for (std::size_t i = 0; i < count; ++i) {
+                        if (!p[i].infinity && !q[i].infinity) {
+                            pairs.push_back(&p[i]);
+                            q_pairs.push_back(&q[i]);
+                            r.push_back({load(q[i].x), load(q[i].y), fp2::one()});
+                        }
+                    }
+                    return miller_loop(pairs, [&](std::size_t j, bool addition) {
+                        return addition ? addition_step(r[j], load(q_pairs[j]->x), load(q_pairs[j]->y))
+                                        : doubling_step(r[j]);
+                    });
+                }
+
+                fp12_381 multi_miller_loop(const g1_affine *p, const g2_prepared *const *q, std::size_t count) {
+                    std::vector<const g1_affine *> pairs;
+                    std::vector<const g2_line *> next;
+                    for (std::size_t i = 0; i < count; ++i) {
+                        if (!p[i].infinity && !q[i]->infinity) {
+                            pairs.push_back(&p[i]);
+                            next.push_back(q[i]->lines.data());
+                        }
+                    }
+                    return miller_loop(pairs, [&](std::size_t j, bool) {
+                        const g2_line &l = *next[j]++;
+                        return line {load(l.c0), load(l.c1), load(l.c2)};
+                    });
+                }
+
+                fp12_381 multiply_miller_loops(const fp12_381 &a, const fp12_381 &b) {
+                    return fp12::store(fp12::mul(fp12::load(a), fp12::load(b)));
+                }
+
+                /**
+                 * f^((p^12 - 1) / r) up to a fixed power coprime to r: the easy part (p^6 - 1)(p^2 + 1) by
+                 * conjugation, inversion and Frobenius, the hard part by the addition chain in u of
+                 * Fuentes-Castaneda, Knapp and Rodriguez-Henriquez, which raises to 3 (p^4 - p^2 + 1) / r.
+                 */
+                fp12_381 final_exponentiation(const fp12_381 &value) {
+                    fp12_type f = fp12::load(value);
+                    fp12_type t2 = fp12::mul(fp12::conjugate(f), fp12::inverse(f));
+                    t2 = fp12::mul(frobenius(t2, 2), t2);
+
+                    fp12_type t1 = fp12::conjugate(fp12::cyclotomic_sqr(t2));
+                    fp12_type t3 = cyclotomic_exp_by_u(t2);
+                    fp12_type t4 = fp12::cyclotomic_sqr(t3);
+                    fp12_type t5 = fp12::mul(t1, t3);
+                    t1 = cyclotomic_exp_by_u(t5);
+                    fp12_type t0 = cyclotomic_exp_by_u(t1);
+                    fp12_type t6 = fp12::mul(cyclotomic_exp_by_u(t0), t4);
+                    t4 = cyclotomic_exp_by_u(t6);
+                    t4 = fp12::mul(t4, fp12::mul(fp12::conjugate(t5), t2));
+                    t1 = frobenius(fp12::mul(t1, t2), 3);
+                    t6 = frobenius(fp12::mul(t6, fp12::conjugate(t2)), 1);
+                    t3 = frobenius(fp12::mul(t3, t0), 2);
+                    t3 = fp12::mul(fp12::mul(t3, t1), t6);
+                    return fp12::store(fp12::mul(t3, t4));
+                }
+
+                bool is_one(const fp12_381 &f) {
+                    auto equal = [](const fp2_381 &a, const fp2_381 &b) {
+                        return a.c0.limbs == b.c0.limbs && a.c1.limbs == b.c1.limbs;
+                    };
+                    const fp12_381 one = fp12::store(fp12::one());
+                    return equal(f.c0.c0, one.c0.c0) && equal(f.c0.c1, one.c0.c1) && equal(f.c0.c2, one.c0.c2) &&
+                           equal(f.c1.c0, one.c1.c0) && equal(f.c1.c1, one.c1.c1) && equal(f.c1.c2, one.c1.c2);
+                }
+
+                bool pairing_product_is_one(const g1_affine *p, const g2_affine *q, std::size_t count) {
+                    return is_one(final_exponentiation(multi_miller_loop(p, q, count)));
+                }
+
+                pairing_timings time_pairing(std::size_t iterations) {
+                    using clock = std::chrono::steady_clock;
+                    using nanoseconds = std::chrono::duration<double, std::nano>;
+
+                    const g1_affine p = to_affine(g1_generator());
+                    const g2_affine q = to_affine(g2_generator());
+                    pairing_timings timings;
+
+                    // Each loop feeds its result back in, so iterations cannot overlap or be skipped.
+                    auto start = clock::now();
+                    fp12_381 f = multi_miller_loop(&p, &q, 1);
+                    for (std::size_t i = 1; i < iterations; ++i) {
+                        f = multiply_miller_loops(f, multi_miller_loop(&p, &q, 1));
+                    }
+                    timings.miller_loop = nanoseconds(clock::now() - start).count() / iterations;
+
+                    fp12_type a = fp12::load(f);
+                    const fp12_type b = a;
+                    const std::size_t operations = 100 * iterations;
+                    start = clock::now();
+                    for (std::size_t i = 0; i < operations; ++i) {
+                        a = fp12::mul(a, b);
+                    }
+                    timings.fp12_mul = nanoseconds(clock::now() - start).count() / operations;
+
+                    start = clock::now();
+                    for (std::size_t i = 0; i < operations; ++i) {
+                        a = fp12::sqr(a);
+                    }
+                    timings.fp12_sqr = nanoseconds(clock::now() - start).count() / operations;
+
+                    fp2_type x = a.c0.c0;
+                    const fp2_type y = a.c1.c2;
+                    start = clock::now();
+                    for (std::size_t i = 0; i < operations; ++i) {
+                        x = fp2::mul(x, y);
+                    }
+                    timings.fp2_mul = nanoseconds(clock::now() - start).count() / operations;
+
+                    start = clock::now();
+                    for (std::size_t i = 0; i < iterations; ++i) {
+                        f = final_exponentiation(f);
+                    }
+                    timings.final_exponentiation = nanoseconds(clock::now() - start).count() / iterations;
+
+                    fp12_type c = fp12::load(f);
+                    start = clock::now();
+                    for (std::size_t i = 0; i < operations; ++i) {
+                        c = fp12::cyclotomic_sqr(c);
+                    }
+                    timings.fp12_cyclotomic_sqr = nanoseconds(clock::now() - start).count() / operations;
+
+                    timing_sink = a.c0.c0.c0.limbs[0] ^ x.c0.limbs[0] ^ c.c0.c0.c0.limbs[0];
+                    return timings;
+                }
+            }    // namespace arithmetic
+        }        // namespace cli
+    }            // namespace crypto3
+}    // namespace nil
@@ -1,8 +1,20 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <functional>
 #include <filesystem>
+#include <optional>
+#include <thread>
+#include <random>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
@@ -15,10 +27,24 @@
 
 #include <nil/crypto3/zk/commitments/polynomial/powers_of_tau.hpp>
 
-#include <nil/crypto3/marshalling/zk/types/commitments/powers_of_tau/accumulator.hpp>
+#include <nil/crypto3/marshalling/algebra/types/curve_element.hpp>
 #include <nil/crypto3/marshalling/zk/types/commitments/powers_of_tau/public_key.hpp>
 #include <nil/crypto3/marshalling/zk/types/commitments/powers_of_tau/result.hpp>
 
+#include <nil/crypto3/cli/accumulator_view.hpp>
+#include <nil/crypto3/cli/arithmetic/curve_kernels.hpp>
+#include <nil/crypto3/cli/arithmetic/kernels.hpp>
+#include <nil/crypto3/cli/arithmetic/pairing.hpp>
+#include <nil/crypto3/cli/arithmetic/point_codec.hpp>
+#include <nil/crypto3/cli/container.hpp>
+#include <nil/crypto3/cli/huge_pages.hpp>
+#include <nil/crypto3/cli/reader.hpp>
+#include <nil/crypto3/cli/reduce.hpp>
+#include <nil/crypto3/cli/scheduler.hpp>
+#include <nil/crypto3/cli/transform.hpp>
+#include <nil/crypto3/cli/validation_cache.hpp>
+#include <nil/crypto3/cli/verify.hpp>
+
 using namespace nil::crypto3;
 
 using curve_type = algebra::curves::bls12<381>;
@@ -34,12 +60,12 @@ namespace po = boost::program_options;
 struct marshalling_policy {
     using endianness = nil::marshalling::option::little_endian;
     using field_base_type = nil::marshalling::field_type<endianness>;
-    using accumulator_marshalling_type =
-        nil::crypto3::marshalling::types::powers_of_tau_accumulator<field_base_type, accumulator_type>;
     using public_key_marshalling_type =
         nil::crypto3::marshalling::types::powers_of_tau_public_key<field_base_type, public_key_type>;
     using result_marshalling_type =
         nil::crypto3::marshalling::types::powers_of_tau_result<field_base_type, result_type>;
+    template<typename GroupType>
+    using curve_element_marshalling_type = nil::crypto3::marshalling::types::curve_element<field_base_type, GroupType>;
 
     template<typename MarshalingType, typename InputObj, typename F>
     static std::vector<std::uint8_t> serialize_obj(const InputObj &in_obj, const std::function<F> &f) {
@@ -63,49 +89,134 @@ struct marshalling_policy {
         return f(marshaling_obj);
     }
 
-    static std::vector<std::uint8_t> serialize_accumulator(const accumulator_type &acc) {
-        return serialize_obj<accumulator_marshalling_type>(
-            acc,
-            std::function(
-                nil::crypto3::marshalling::types::fill_powers_of_tau_accumulator<accumulator_type, endianness>));
+    template<typename GroupType>
+    static std::size_t element_size() {
+        static const std::size_t size = nil::crypto3::marshalling::types::fill_curve_element<GroupType, endianness>(
+                                            GroupType::value_type::one())
+                                            .length();
+        return size;
     }
 
-    template<typename InputIterator>
-    static accumulator_type deserialize_accumulator(InputIterator first, InputIterator last) {
-        return deserialize_obj<accumulator_marshalling_type, accumulator_type>(
-            first, last,
-            std::function(
-                nil::crypto3::marshalling::types::make_powers_of_tau_accumulator<accumulator_type, endianness>));
+    template<typename GroupType, typename OutputIterator>
+    static void serialize_element(const typename GroupType::value_type &point, OutputIterator out) {
+        curve_element_marshalling_type<GroupType> filled_val =
+            nil::crypto3::marshalling::types::fill_curve_element<GroupType, endianness>(point);
+        nil::marshalling::status_type status = filled_val.write(out, filled_val.length());
+        if (status != nil::marshalling::status_type::success) {
+            throw std::invalid_argument("invalid format");
+        }
     }
 
-    static std::vector<std::uint8_t> serialize_public_key(const public_key_type &public_key) {
-        return serialize_obj<public_key_marshalling_type>(
-            public_key,
-            std::function(
-                nil::crypto3::marshalling::types::fill_powers_of_tau_public_key<public_key_type, endianness>));
+    template<typename GroupType, typename InputIterator>
+    static typename GroupType::value_type deserialize_element(InputIterator first, InputIterator last) {
+        return deserialize_obj<curve_element_marshalling_type<GroupType>, typename GroupType::value_type>(
+            first, last, std::function(nil::crypto3::marshalling::types::make_curve_element<GroupType, endianness>));
     }
 
-    template<typename InputIterator>
-    static std::pair<accumulator_type, public_key_type> deserialize_response(InputIterator first, InputIterator last) {
-        accumulator_marshalling_type acc_marsh;
-        nil::marshalling::status_type status = acc_marsh.read(first, std::distance(first, last));
-        if (status != nil::marshalling::status_type::success) {
-            throw std::invalid_argument("invalid response format");
+    /**
+     * The byte order in which the fixed-size point_codec reproduces the encoding above, found once by
+     * round-tripping a few points, the generator among them, through both; none if it doesn't, and the bulk
+     * functions below fall back to the generic path for good.
+     */
+    template<typename GroupType>
+    static std::optional<cli::arithmetic::byte_order> fixed_size_order() {
+        static const std::optional<cli::arithmetic::byte_order> order = probe_fixed_size_order<GroupType>();
+        return order;
+    }
+
+    template<typename GroupType>
+    static std::optional<cli::arithmetic::byte_order> probe_fixed_size_order() {
+        using value_type = typename GroupType::value_type;
+        using codec_type = cli::arithmetic::point_codec<value_type>;
+        if constexpr (codec_type::available) {
+            const std::array<value_type, 3> points = {value_type::one(), -(value_type::one() + value_type::one()),
+                                                      value_type::zero()};
+            const std::size_t size = element_size<GroupType>();
+            if (size != codec_type::size) {
+                return std::nullopt;
+            }
+            std::vector<std::uint8_t> generic(points.size() * size);
+            for (std::size_t i = 0; i < points.size(); ++i) {
+                serialize_element<GroupType>(points[i], generic.begin() + i * size);
+            }
+            for (cli::arithmetic::byte_order order :
+                 {cli::arithmetic::byte_order::big_endian, cli::arithmetic::byte_order::little_endian}) {
+                std::vector<std::uint8_t> fixed(generic.size());
+                codec_type::encode(points.data(), points.size(), fixed.data(), order);
+                std::array<value_type, 3> decoded;
+                if (fixed == generic && codec_type::decode(generic.data(), points.size(), decoded.data(), order) &&
+                    decoded == points) {
+                    return order;
+                }
+            }
         }
+        return std::nullopt;
+    }
 
-        accumulator_type acc =
-            nil::crypto3::marshalling::types::make_powers_of_tau_accumulator<accumulator_type, endianness>(acc_marsh);
+    /// Encodes count points into consecutive records of element_size bytes.
+    template<typename GroupType>
+    static void serialize_elements(const typename GroupType::value_type *points, std::size_t count,
+                                   std::uint8_t *out) {
+        using codec_type = cli::arithmetic::point_codec<typename GroupType::value_type>;
+        if constexpr (codec_type::available) {
+            if (std::optional<cli::arithmetic::byte_order> order = fixed_size_order<GroupType>()) {
+                codec_type::encode(points, count, out, *order);
+                return;
+            }
+        }
+        const std::size_t size = element_size<GroupType>();
+        for (std::size_t i = 0; i < count; ++i) {
+            serialize_element<GroupType>(points[i], out + i * size);
+        }
+    }
 
-        public_key_marshalling_type pk_marsh;
-        status = pk_marsh.read(first, std::distance(first, last) - acc_marsh.length());
-        if (status != nil::marshalling::status_type::success) {
-            throw std::invalid_argument("invalid response format");
+    /// Decodes count consecutive records. A batch the fixed-size codec rejects is decoded again the generic way,
+    /// which has the last word on what is malformed.
+    template<typename GroupType>
+    static void deserialize_elements(const std::uint8_t *in, std::size_t count,
+                                     typename GroupType::value_type *points) {
+        using codec_type = cli::arithmetic::point_codec<typename GroupType::value_type>;
+        if constexpr (codec_type::available) {
+            std::optional<cli::arithmetic::byte_order> order = fixed_size_order<GroupType>();
+            if (order && codec_type::decode(in, count, points, *order)) {
+                return;
+            }
         }
+        const std::size_t size = element_size<GroupType>();
+        for (std::size_t i = 0; i < count; ++i) {
+            points[i] = deserialize_element<GroupType>(in + i * size, in + (i + 1) * size);
+        }
+    }
+
+    /// Throws unless every point is on the curve and in the prime-order subgroup.
+    template<typename GroupType>
+    static void validate_elements(const typename GroupType::value_type *points, std::size_t count) {
+        if (cli::arithmetic::curve_kernels<curve_type>::validate(points, count) != count) {
+            throw std::invalid_argument("point outside the prime-order subgroup");
+        }
+    }
+
+    /// Throws unless every point is on the curve; for points known to be in the subgroup.
+    template<typename GroupType>
+    static void validate_curve_elements(const typename GroupType::value_type *points, std::size_t count) {
+        if (cli::arithmetic::curve_kernels<curve_type>::on_curve(points, count) != count) {
+            throw std::invalid_argument("point not on the curve");
+        }
+    }
 
-        public_key_type pk =
-            nil::crypto3::marshalling::types::make_powers_of_tau_public_key<public_key_type, endianness>(pk_marsh);
+    static std::vector<std::uint8_t> serialize_public_key(const public_key_type &public_key) {
+        return serialize_obj<public_key_marshalling_type>(
+            public_key,
+            std::function(
+                nil::crypto3::marshalling::types::fill_powers_of_tau_public_key<public_key_type, endianness>));
+    }
 
-        return {acc, pk};
+    template<typename InputIterator>
+    static public_key_type deserialize_public_key(InputIterator first, InputIterator last) {
+        return deserialize_obj<public_key_marshalling_type, public_key_type>(
+            first, last,
+            std::function(
+                nil::crypto3::marshalling::types::make_powers_of_tau_public_key<public_key_type, endianness>));
     }
 
     static std::vector<std::uint8_t> serialize_result(const result_type &res) {
@@ -130,42 +241,320 @@ struct marshalling_policy {
     }
 
     template<typename Path>
-    static std::vector<std::uint8_t> read_obj(const Path &path) {
-        BOOST_ASSERT_MSG(
-            std::filesystem::exists(path),
-            (std::string("File ") + path + std::string(" doesn't exist, make sure you created it!")).c_str());
-        std::ifstream in(path, std::ios_base::binary);
-        std::stringstream buffer;
-        buffer << in.rdbuf();
-        auto blob_str = buffer.str();
-        return {std::cbegin(blob_str), std::cend(blob_str)};
+    static bool write_accumulator(cli::scheduler &sched,
+                                  const Path &path,
+                                  const accumulator_type &acc,
+                                  const std::vector<std::uint8_t> &public_key_blob = {},
+                                  cli::point_encoding encoding = cli::point_encoding::compressed,
+                                  cli::validation_cache *validated = nullptr) {
+        if (std::filesystem::exists(path)) {
+            std::cout << "File " << path << " exists and won't be overwritten." << std::endl;
+            return false;
+        }
+        cli::write_container<marshalling_policy, curve_type>(sched, path, acc, public_key_blob, encoding, validated);
+        return true;
     }
 };
 
+using reader_type = cli::accumulator_reader<marshalling_policy, curve_type>;
+using view_type = cli::accumulator_view<marshalling_policy, curve_type>;
+
+accumulator_type read_accumulator(cli::scheduler &sched, reader_type &reader) {
+    using g1_type = curve_type::template g1_type<>;
+    using g2_type = curve_type::template g2_type<>;
+
+    const cli::accumulator_layout &layout = reader.layout();
+    return accumulator_type(
+        reader.read<g1_type>(sched, cli::section::tau_g1, 0, layout[cli::section::tau_g1].count),
+        reader.read<g2_type>(sched, cli::section::tau_g2, 0, layout[cli::section::tau_g2].count),
+        reader.read<g1_type>(sched, cli::section::alpha_tau_g1, 0, layout[cli::section::alpha_tau_g1].count),
+        reader.read<g1_type>(sched, cli::section::beta_tau_g1, 0, layout[cli::section::beta_tau_g1].count),
+        reader.read<g2_type>(sched, cli::section::beta_g2, 0, 1).front());
+}
+
+public_key_type read_public_key(reader_type &reader) {
+    std::vector<std::uint8_t> public_key_blob = reader.read_public_key();
+    return marshalling_policy::deserialize_public_key(public_key_blob.cbegin(), public_key_blob.cend());
+}
+
 accumulator_type init_ceremony() {
     accumulator_type acc;
     return acc;
 }
 
-public_key_type contribute_randomness(accumulator_type &acc) {
+public_key_type contribute_randomness(cli::scheduler &sched, accumulator_type &acc) {
     private_key_type private_key = scheme_type::generate_private_key();
     public_key_type public_key = scheme_type::proof_eval(private_key, acc);
 
-    acc.transform(private_key);
+    cli::transform<scheme_type>(sched, acc, private_key);
     return public_key;
 }
 
-bool verify_contribution(const accumulator_type &before,
-                         const accumulator_type &after,
-                         const public_key_type &public_key) {
-    return scheme_type::verify_eval(public_key, before, after);
+/**
+ * Checks a response still in memory against the challenge it was computed from, with the same batched random
+ * linear combination verify uses: a few multi-scalar multiplications over the response and one multi-pairing,
+ * none of the decoding and validation of a full verify.
+ */
+bool check_contribution(cli::scheduler &sched,
+                        const accumulator_type &challenge_prefix,
+                        const accumulator_type &response,
+                        const public_key_type &public_key) {
+    return cli::verify_against_prefix<scheme_type>(sched, public_key, challenge_prefix, response);
+}
+
+/// Whether the two files hold as many powers, section by section.
+bool same_powers(const cli::accumulator_layout &challenge, const cli::accumulator_layout &response) {
+    if (challenge.tau_powers != response.tau_powers) {
+        return false;
+    }
+    for (std::size_t i = 0; i < cli::accumulator_sections_count; ++i) {
+        if (challenge.sections[i].count != response.sections[i].count) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool verify_contribution(cli::scheduler &sched,
+                         const view_type &before,
+                         const view_type &after,
+                         const public_key_type &public_key,
+                         bool fail_fast) {
+    return cli::verify<scheme_type>(sched, public_key, before, after, fail_fast);
+}
+
+const char *describe(cli::section where) {
+    switch (where) {
+        case cli::section::tau_g1:
+            return "tau_g1";
+        case cli::section::tau_g2:
+            return "tau_g2";
+        case cli::section::alpha_tau_g1:
+            return "alpha_tau_g1";
+        case cli::section::beta_tau_g1:
+            return "beta_tau_g1";
+        case cli::section::beta_g2:
+            return "beta_g2";
+        case cli::section::public_key:
+            return "public key";
+    }
+    return "";
+}
+
+/// Reports what makes a contribution invalid, down to the section and the powers.
+void locate_inconsistencies(cli::scheduler &sched,
+                            const view_type &before,
+                            const view_type &after,
+                            const public_key_type &public_key) {
+    for (const cli::inconsistency &found : cli::locate<scheme_type>(sched, public_key, before, after)) {
+        std::cout << "  " << describe(found.where);
+        if (found.where == cli::section::public_key) {
+            std::cout << ": ";
+        } else if (found.first == found.last) {
+            std::cout << " power " << found.first << ": ";
+        } else {
+            std::cout << " powers " << found.first << " to " << found.last << ": ";
+        }
+        std::cout << found.reason << std::endl;
+    }
 }
 
 result_type create_radix(const accumulator_type &acc, std::size_t m) {
     return result_type::from_accumulator(acc, m);
 }
 
-int main(int argc, char *argv[]) {
+/**
+ * Reads only the powers a radix of size m depends on: tau^0 .. tau^(2m - 2) in G1 for the H query and
+ * tau^0 .. tau^(m - 1) everywhere else.
+ */
+accumulator_type read_radix_prefix(cli::scheduler &sched, const view_type &view, std::size_t m) {
+    return accumulator_type(view.tau_powers_g1.decode(sched, 0, 2 * m - 1),
+                            view.tau_powers_g2.decode(sched, 0, m),
+                            view.alpha_tau_powers_g1.decode(sched, 0, m),
+                            view.beta_tau_powers_g1.decode(sched, 0, m),
+                            view.beta_g2);
+}
+
+/// The validation cache to load with, if one was given.
+cli::validation_cache *cache_of(std::optional<cli::validation_cache> &validated) {
+    return validated ? &*validated : nullptr;
+}
+
+const char *describe(cli::arithmetic::kernel_dispatch::status result) {
+    switch (result) {
+        case cli::arithmetic::kernel_dispatch::status::unsupported:
+            return "not supported by this CPU";
+        case cli::arithmetic::kernel_dispatch::status::untested:
+            return "supported, not tested";
+        case cli::arithmetic::kernel_dispatch::status::passed:
+            return "self-test passed";
+        case cli::arithmetic::kernel_dispatch::status::failed:
+            return "self-test FAILED";
+    }
+    return "";
+}
+
+/**
+ * Picks the arithmetic backend up front, self-test included, rather than when the first batch of points needs it,
+ * and reports the choice if asked to.
+ */
+void select_kernels(bool verbose) {
+    const cli::arithmetic::kernel_dispatch &dispatch = cli::arithmetic::dispatch();
+    if (!verbose) {
+        return;
+    }
+    const cli::arithmetic::cpu_features &features = dispatch.features;
+    std::cout << "CPU features:" << (features.bmi2 ? " bmi2" : "") << (features.adx ? " adx" : "")
+              << (features.avx2 ? " avx2" : "") << (features.avx512ifma ? " avx512ifma" : "") << std::endl;
+    std::cout << "Arithmetic backends:" << std::endl;
+    for (const cli::arithmetic::kernel_dispatch::candidate &candidate : dispatch.candidates) {
+        std::cout << "  " << candidate.table->name << ": " << describe(candidate.result)
+                  << (candidate.table == dispatch.selected ? ", selected" : "") << std::endl;
+    }
+}
+
+/**
+ * Times [k] P in G1 and G2 on every backend this CPU supports, after the same self-test the dispatcher runs, so it
+ * doubles as a check of all of them, e.g. under an emulator.
+ */
+bool benchmark_kernels(std::size_t count) {
+    std::mt19937_64 random_engine(std::random_device {}());
+    std::vector<cli::arithmetic::scalar256> scalars(count);
+    for (cli::arithmetic::scalar256 &k : scalars) {
+        for (std::uint64_t &limb : k.limbs) {
+            limb = random_engine();
+        }
+    }
+
+    bool all_passed = true;
+    for (const cli::arithmetic::kernel_dispatch::candidate &candidate : cli::arithmetic::dispatch().candidates) {
+        if (candidate.result == cli::arithmetic::kernel_dispatch::status::unsupported) {
+            continue;
+        }
+        const cli::arithmetic::kernel_table &table = *candidate.table;
+        bool passed = cli::arithmetic::self_test(table);
+        all_passed = all_passed && passed;
+
+        cli::arithmetic::point_columns<cli::arithmetic::g1_raw> g1(count);
+        cli::arithmetic::point_columns<cli::arithmetic::g2_raw> g2(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            g1[i] = cli::arithmetic::g1_generator();
+            g2[i] = cli::arithmetic::g2_generator();
+        }
+        auto start = std::chrono::steady_clock::now();
+        table.g1_mul(g1, scalars.data());
+        auto middle = std::chrono::steady_clock::now();
+        table.g2_mul(g2, scalars.data());
+        auto end = std::chrono::steady_clock::now();
+
+        using microseconds = std::chrono::duration<double, std::micro>;
+        std::cout << table.name << ": " << (passed ? "self-test passed" : "self-test FAILED") << ", G1 "
+                  << microseconds(middle - start).count() / count << " us, G2 "
+                  << microseconds(end - middle).count() / count << " us per scalar multiplication" << std::endl;
+    }
+    return all_passed;
+}
+
+/// Times the pairing and the extension field arithmetic beneath it, which dominate verification.
+void benchmark_pairing(std::size_t count) {
+    cli::arithmetic::pairing_timings timings = cli::arithmetic::time_pairing(count);
+    std::cout << "pairing: Fp2 mul " << timings.fp2_mul << " ns, Fp12 mul " << timings.fp12_mul << " ns, Fp12 square "
+              << timings.fp12_sqr << " ns, cyclotomic square " << timings.fp12_cyclotomic_sqr << " ns" << std::endl;
+    std::cout << "pairing: Miller loop " << timings.miller_loop / 1000 << " us, final exponentiation "
+              << timings.final_exponentiation / 1000 << " us" << std::endl;
+}
+
+#if defined(__linux__)
+/// Counts the data TLB misses of the calling thread from construction on, where perf events are permitted.
+class tlb_miss_counter {
+public:
+    tlb_miss_counter() {
+        perf_event_attr attr {};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    tlb_miss_counter(const tlb_miss_counter &) = delete;
+    tlb_miss_counter &operator=(const tlb_miss_counter &) = delete;
+
+    ~tlb_miss_counter() {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    /// Misses so far, or -1 if they can't be counted.
+    long long count() const {
+        long long misses = 0;
+        if (fd < 0 || ::read(fd, &misses, sizeof(misses)) != sizeof(misses)) {
+            return -1;
+        }
+        return misses;
+    }
+
+private:
+    int fd;
+};
+#else
+/// Perf events are Linux's own; elsewhere the misses can't be counted.
+class tlb_miss_counter {
+public:
+    long long count() const {
+        return -1;
+    }
+};
+#endif
+
+/**
+ * Times random reads over a buffer the size of a power vector, with the default allocator and with huge pages,
+ * the access pattern of the strided transform passes at its worst for the TLB.
+ */
+void benchmark_memory(std::size_t mebibytes) {
+    constexpr std::size_t reads = 1 << 22;
+    auto measure = [&](const char *name, const auto &buffer) {
+        std::uint64_t index = 0, sum = 0;
+        tlb_miss_counter misses;
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < reads; ++i) {
+            index = index * 6364136223846793005ULL + 1442695040888963407ULL;
+            sum += buffer[(index >> 16) % buffer.size()];
+        }
+        auto end = std::chrono::steady_clock::now();
+        long long count = misses.count();
+        // Keeps the reads from being optimized away.
+        volatile std::uint64_t sink = sum;
+        static_cast<void>(sink);
+
+        using nanoseconds = std::chrono::duration<double, std::nano>;
+        std::cout << "memory: " << name << " " << nanoseconds(end - start).count() / reads << " ns per random read";
+        if (count >= 0) {
+            std::cout << ", " << static_cast<double>(count) / reads << " dTLB misses per read";
+        }
+        std::cout << std::endl;
+    };
+
+    std::size_t words = (mebibytes << 20) / sizeof(std::uint64_t);
+    {
+        std::vector<std::uint64_t> buffer(words, 1);
+        measure("4 KiB pages", buffer);
+    }
+    {
+        std::vector<std::uint64_t, cli::huge_page_allocator<std::uint64_t>> buffer(words, 1);
+        measure("huge pages", buffer);
+    }
+}
+
+constexpr int usage_error_exit_code = 1;
+constexpr int help_message_exit_code = 2;
+constexpr int invalid_exit_code = 3;
+constexpr int file_exists_exit_code = 4;
+
+int run_command(int argc, char *argv[]) {
     std::string description =
         "Powers of Tau, A Trusted Setup Multi Party Computation Protcol\n"
         "Usage:\n"
@@ -174,12 +563,14 @@ int main(int argc, char *argv[]) {
         "verify - Verify a contribution to the trusted setup\n"
         "create-radix - Create a radix evalutation domain from\n"
         " the last response in the ceremony.\n"
+        "reduce - Extract a smaller ceremony from the first powers\n"
+        " of a larger challenge or response.\n"
+        "convert - Rewrite a challenge or response with its points\n"
+        " in the native format the coordinator keeps, or back.\n"
+        "bench - Check and time the arithmetic backends, the pairing and memory access\n"
         "Run `cli subcommand --help` for details about a specific subcommand";
 
-    int usage_error_exit_code = 1;
-    int help_message_exit_code = 2;
-    int invalid_exit_code = 3;
-    int file_exists_exit_code = 4;
+    std::size_t default_threads = std::max(std::thread::hardware_concurrency(), 1u);
 
     if (argc < 2) {
         std::cout << description << std::endl;
@@ -190,7 +581,8 @@ int main(int argc, char *argv[]) {
     if (command == "init") {
         po::options_description desc("init - Initialize a trusted setup MPC ceremony");
         desc.add_options()("help,h", "Display help message")("output,o", po::value<std::string>(),
-                                                             "Initial challenge output path");
+                                                             "Initial challenge output path")(
+            "threads,t", po::value<std::size_t>()->default_value(default_threads), "Number of worker threads");
 
         po::variables_map vm;
         po::store(po::parse_command_line(argc - 1, argv + 1, desc), vm);
@@ -208,13 +600,13 @@ int main(int argc, char *argv[]) {
         }
 
         std::string output_path = vm["output"].as<std::string>();
+        cli::scheduler sched(vm["threads"].as<std::size_t>());
         std::cout << "Initializing Powers Of Tau challenge..." << std::endl;
         auto acc = init_ceremony();
 
         std::cout << "Writing to file..." << std::endl;
 
-        std::vector<std::uint8_t> acc_blob = marshalling_policy::serialize_accumulator(acc);
-        if (!marshalling_policy::write_obj(output_path, {acc_blob})) {
+        if (!marshalling_policy::write_accumulator(sched, output_path, acc)) {
             return file_exists_exit_code;
         }
         std::cout << "Challenge written to " << output_path << std::endl;
@@ -222,7 +614,11 @@ int main(int argc, char *argv[]) {
         po::options_description desc("contribute - Contribute randomness to the trusted setup");
         desc.add_options()("help,h", "Display help message")(
             "challenge,c", po::value<std::string>(), "challenge input path")("output,o", po::value<std::string>(),
-                                                                             "Response output path");
+                                                                             "Response output path")(
+            "threads,t", po::value<std::size_t>()->default_value(default_threads), "Number of worker threads")(
+            "self-check", "Check the response against the challenge before writing it, at a fraction of the cost "
+                          "of verify")(
+            "verbose,v", "Report the CPU features and the arithmetic backend in use");
 
         po::variables_map vm;
         po::store(po::parse_command_line(argc - 1, argv + 1, desc), vm);
@@ -247,22 +643,37 @@ int main(int argc, char *argv[]) {
 
         std::string challenge_path = vm["challenge"].as<std::string>();
         std::string output_path = vm["output"].as<std::string>();
+        cli::scheduler sched(vm["threads"].as<std::size_t>());
+        select_kernels(vm.count("verbose") != 0);
 
         std::cout << "Reading challenge file: " << challenge_path << std::endl;
 
-        std::vector<std::uint8_t> challenge_blob = marshalling_policy::read_obj(challenge_path);
-        accumulator_type acc =
-            marshalling_policy::deserialize_accumulator(challenge_blob.begin(), challenge_blob.end());
+        reader_type challenge_reader(challenge_path, false);
+        accumulator_type acc = read_accumulator(sched, challenge_reader);
+        // The transform overwrites the challenge in place; the check needs no more of it than its first powers.
+        std::optional<accumulator_type> challenge_prefix;
+        if (vm.count("self-check")) {
+            challenge_prefix = cli::powers_prefix(acc, 2);
+        }
 
         std::cout << "Contributing randomness..." << std::endl;
 
-        public_key_type public_key = contribute_randomness(acc);
+        public_key_type public_key = contribute_randomness(sched, acc);
+
+        if (challenge_prefix) {
+            std::cout << "Checking the response..." << std::endl;
+            if (!check_contribution(sched, *challenge_prefix, acc, public_key)) {
+                std::cout << "The response doesn't match the challenge and won't be written; the computation went "
+                             "wrong on this machine, contribute again."
+                          << std::endl;
+                return invalid_exit_code;
+            }
+        }
 
         std::cout << "Writing to file..." << std::endl;
 
-        std::vector<std::uint8_t> response_acc_blob = marshalling_policy::serialize_accumulator(acc);
         std::vector<std::uint8_t> public_key_blob = marshalling_policy::serialize_public_key(public_key);
-        if (!marshalling_policy::write_obj(output_path, {response_acc_blob, public_key_blob})) {
+        if (!marshalling_policy::write_accumulator(sched, output_path, acc, public_key_blob)) {
             return file_exists_exit_code;
         }
 
@@ -271,7 +682,14 @@ int main(int argc, char *argv[]) {
         po::options_description desc("verify - Contribute randomness to the trusted setup");
         desc.add_options()("help,h", "Display help message")(
             "challenge,c", po::value<std::string>(), "Path to challenge file")("response,r", po::value<std::string>(),
-                                                                               "Path to response file");
+                                                                               "Path to response file")(
+            "threads,t", po::value<std::size_t>()->default_value(default_threads), "Number of worker threads")(
+            "cache-size", po::value<std::size_t>()->default_value(1024), "Decoded point cache size in MiB")(
+            "validation-cache", po::value<std::string>(),
+            "List of the point records this host checked in full, which are then loaded without subgroup checks")(
+            "fail-fast", "Stop at the first claim found not to hold instead of checking them all at once")(
+            "locate", "If the contribution is invalid, report which sections and powers are inconsistent")(
+            "verbose,v", "Report the CPU features and the arithmetic backend in use");
 
         po::variables_map vm;
         po::store(po::parse_command_line(argc - 1, argv + 1, desc), vm);
@@ -296,30 +714,73 @@ int main(int argc, char *argv[]) {
 
         std::string challenge_path = vm["challenge"].as<std::string>();
         std::string response_path = vm["response"].as<std::string>();
+        cli::scheduler sched(vm["threads"].as<std::size_t>());
+        select_kernels(vm.count("verbose") != 0);
 
         std::cout << "Reading files challenge: " << challenge_path << " response: " << response_path << std::endl;
 
-        std::vector<std::uint8_t> challenge_blob = marshalling_policy::read_obj(challenge_path);
-        std::vector<std::uint8_t> response_blob = marshalling_policy::read_obj(response_path);
-        accumulator_type before =
-            marshalling_policy::deserialize_accumulator(challenge_blob.begin(), challenge_blob.end());
-        auto [after, pk] = marshalling_policy::deserialize_response(response_blob.begin(), response_blob.end());
+        std::optional<cli::validation_cache> validated;
+        if (vm.count("validation-cache")) {
+            validated.emplace(vm["validation-cache"].as<std::string>());
+        }
 
-        std::cout << "Verifying contribution..." << std::endl;
+        // Points are decoded as the checks reach them, so memory use is bounded by the cache, not the ceremony.
+        std::size_t cache_bytes = vm["cache-size"].as<std::size_t>() << 20;
+        reader_type challenge_reader(challenge_path, false);
+        reader_type response_reader(response_path, true);
 
-        bool is_valid = verify_contribution(before, after, pk);
-        std::cout << (is_valid ? "Contribution is valid!" : "Contribution is invalid!") << std::endl;
-        if (!is_valid) {
+        // A response of another size than the challenge isn't a contribution to it, whatever its points.
+        if (!same_powers(challenge_reader.layout(), response_reader.layout())) {
+            std::cout << "The response has " << response_reader.tau_powers() << " powers where the challenge has "
+                      << challenge_reader.tau_powers() << std::endl;
+            std::cout << "Contribution is invalid!" << std::endl;
             return 1;
         }
 
+        // Points are loaded by the checks which need them, so any of them may turn out not to decode or to lie
+        // outside the subgroup; either makes the contribution invalid.
+        try {
+            // Verification only reads the first powers of the challenge, which are checked in full every time.
+            view_type before(challenge_path, challenge_reader.layout(), cache_bytes / 2);
+            view_type after(response_path, response_reader.layout(), cache_bytes / 2, cache_of(validated));
+            public_key_type pk = read_public_key(response_reader);
+
+            std::cout << "Verifying contribution..." << std::endl;
+
+            bool is_valid = verify_contribution(sched, before, after, pk, vm.count("fail-fast") != 0);
+            std::cout << (is_valid ? "Contribution is valid!" : "Contribution is invalid!") << std::endl;
+            if (!is_valid) {
+                if (vm.count("locate")) {
+                    std::cout << "Locating the inconsistencies..." << std::endl;
+                    locate_inconsistencies(sched, before, after, pk);
+                }
+                return 1;
+            }
+        } catch (const cli::bad_point &e) {
+            std::cout << "Power " << e.index << " of " << describe(e.where) << " is invalid: " << e.what()
+                      << std::endl;
+            std::cout << "Contribution is invalid!" << std::endl;
+            return invalid_exit_code;
+        } catch (const std::invalid_argument &e) {
+            std::cout << "The response is malformed: " << e.what() << std::endl;
+            std::cout << "Contribution is invalid!" << std::endl;
+            return invalid_exit_code;
+        }
+        // Only the chunks of a valid contribution are kept; they were listed as they passed their checks.
+        if (validated) {
+            validated->save();
+        }
+
     } else if (command == "create-radix") {
         po::options_description desc(
             "create-radix - Create a radix evalutation domain from the last response in the ceremony.");
         desc.add_options()("help,h", "Display help message")("input,i", po::value<std::string>(),
                                                              "Response input path")(
             "output,o", po::value<std::string>(), "Radix output path")("radix-m,m", po::value<std::size_t>(),
-                                                                       "Radix evalutation domain size");
+                                                                       "Radix evalutation domain size")(
+            "validation-cache", po::value<std::string>(),
+            "List of the point records this host checked in full, which are then loaded without subgroup checks")(
+            "threads,t", po::value<std::size_t>()->default_value(default_threads), "Number of worker threads");
 
         po::variables_map vm;
         po::store(po::parse_command_line(argc - 1, argv + 1, desc), vm);
@@ -351,16 +812,25 @@ int main(int argc, char *argv[]) {
         std::string input_path = vm["input"].as<std::string>();
         std::string output_path = vm["output"].as<std::string>();
         std::size_t m = vm["radix-m"].as<std::size_t>();
+        cli::scheduler sched(vm["threads"].as<std::size_t>());
+
+        std::cout << "Reading response file: " << input_path << std::endl;
+
+        std::optional<cli::validation_cache> validated;
+        if (vm.count("validation-cache")) {
+            validated.emplace(vm["validation-cache"].as<std::string>());
+        }
+        reader_type reader(input_path, true);
         std::size_t real_m = math::make_evaluation_domain<curve_type::scalar_field_type>(m)->m;
-        if (real_m > tau_powers) {
+        if (real_m > reader.tau_powers()) {
             std::cout << "m is too big for this ceremony configuration" << std::endl;
             return usage_error_exit_code;
         }
-
-        std::cout << "Reading response file: " << input_path << std::endl;
-
-        std::vector<std::uint8_t> input_blob = marshalling_policy::read_obj(input_path);
-        accumulator_type acc = marshalling_policy::deserialize_accumulator(input_blob.begin(), input_blob.end());
+        view_type view(input_path, reader.layout(), 0, cache_of(validated));
+        accumulator_type acc = read_radix_prefix(sched, view, real_m);
+        if (validated) {
+            validated->save();
+        }
 
         std::cout << "Computing Radix Evaluation Domain with m=" << m << std::endl;
 
@@ -374,6 +844,161 @@ int main(int argc, char *argv[]) {
         }
 
         std::cout << "Radix written to " << output_path << std::endl;
+    } else if (command == "reduce") {
+        po::options_description desc(
+            "reduce - Extract a smaller ceremony from the first powers of a larger challenge or response.");
+        desc.add_options()("help,h", "Display help message")("input,i", po::value<std::string>(),
+                                                             "Challenge or response input path")(
+            "output,o", po::value<std::string>(), "Reduced output path")(
+            "power,p", po::value<std::size_t>(), "Keep 2^power tau powers")(
+            "response,r", "Input is a response; only needed for files in the old stream format");
+
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc - 1, argv + 1, desc), vm);
+        po::notify(vm);
+
+        if (argc < 3 || vm.count("help")) {
+            std::cout << desc << std::endl;
+            return help_message_exit_code;
+        }
+
+        if (!vm.count("input")) {
+            std::cout << "missing argument -i [ --input ]" << std::endl;
+            std::cout << desc << std::endl;
+            return usage_error_exit_code;
+        }
+
+        if (!vm.count("output")) {
+            std::cout << "missing argument -o [ --output ]" << std::endl;
+            std::cout << desc << std::endl;
+            return usage_error_exit_code;
+        }
+
+        if (!vm.count("power")) {
+            std::cout << "missing argument -p [ --power ]" << std::endl;
+            std::cout << desc << std::endl;
+            return usage_error_exit_code;
+        }
+
+        std::string input_path = vm["input"].as<std::string>();
+        std::string output_path = vm["output"].as<std::string>();
+        std::size_t power = vm["power"].as<std::size_t>();
+
+        reader_type reader(input_path, vm.count("response") != 0);
+        if (power >= 8 * sizeof(std::size_t) || (std::size_t(1) << power) > reader.tau_powers()) {
+            std::cout << "power is too big, the input ceremony has " << reader.tau_powers() << " powers"
+                      << std::endl;
+            return usage_error_exit_code;
+        }
+        if (std::filesystem::exists(output_path)) {
+            std::cout << "File " << output_path << " exists and won't be overwritten." << std::endl;
+            return file_exists_exit_code;
+        }
+
+        std::cout << "Reducing " << input_path << " to " << (std::size_t(1) << power) << " powers..." << std::endl;
+
+        cli::reduce(input_path, reader.layout(), cli::curve_id<curve_type>::value, output_path,
+                    std::size_t(1) << power);
+
+        std::cout << "Reduced ceremony written to " << output_path << std::endl;
+    } else if (command == "convert") {
+        po::options_description desc(
+            "convert - Rewrite a challenge or response with its points in the native format the coordinator keeps, "
+            "or back.");
+        desc.add_options()("help,h", "Display help message")("input,i", po::value<std::string>(),
+                                                             "Challenge or response input path")(
+            "output,o", po::value<std::string>(), "Converted output path")(
+            "native,n", "Write points as this build holds them in memory, for files only the coordinator reads; "
+                        "without it, write them compressed for participants")(
+            "response,r", "Input is a response; only needed for files in the old stream format")(
+            "validation-cache", po::value<std::string>(),
+            "List of the point records this host checked in full, which are then loaded without subgroup checks")(
+            "threads,t", po::value<std::size_t>()->default_value(default_threads), "Number of worker threads");
+
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc - 1, argv + 1, desc), vm);
+        po::notify(vm);
+
+        if (argc < 3 || vm.count("help")) {
+            std::cout << desc << std::endl;
+            return help_message_exit_code;
+        }
+
+        if (!vm.count("input")) {
+            std::cout << "missing argument -i [ --input ]" << std::endl;
+            std::cout << desc << std::endl;
+            return usage_error_exit_code;
+        }
+
+        if (!vm.count("output")) {
+            std::cout << "missing argument -o [ --output ]" << std::endl;
+            std::cout << desc << std::endl;
+            return usage_error_exit_code;
+        }
+
+        std::string input_path = vm["input"].as<std::string>();
+        std::string output_path = vm["output"].as<std::string>();
+        cli::point_encoding encoding =
+            vm.count("native") ? cli::point_encoding::native : cli::point_encoding::compressed;
+        cli::scheduler sched(vm["threads"].as<std::size_t>());
+
+        std::cout << "Reading " << input_path << std::endl;
+
+        std::optional<cli::validation_cache> validated;
+        if (vm.count("validation-cache")) {
+            validated.emplace(vm["validation-cache"].as<std::string>());
+        }
+        reader_type reader(input_path, vm.count("response") != 0, cache_of(validated));
+        accumulator_type acc = read_accumulator(sched, reader);
+        // The public key is a handful of points; it keeps the marshalling encoding either way.
+        std::vector<std::uint8_t> public_key_blob;
+        if (reader.layout().has_public_key()) {
+            public_key_blob = reader.read_public_key();
+        }
+
+        std::cout << "Writing to file..." << std::endl;
+
+        // The output holds the points just checked, so its records are listed as they are written.
+        if (!marshalling_policy::write_accumulator(sched, output_path, acc, public_key_blob, encoding,
+                                                   cache_of(validated))) {
+            return file_exists_exit_code;
+        }
+        if (validated) {
+            validated->save();
+        }
+
+        std::cout << "Converted file written to " << output_path << std::endl;
+    } else if (command == "bench") {
+        po::options_description desc("bench - Check and time the arithmetic backends, the pairing and memory access");
+        desc.add_options()("help,h", "Display help message")(
+            "points,n", po::value<std::size_t>()->default_value(256), "Scalar multiplications per group")(
+            "pairings,p", po::value<std::size_t>()->default_value(16), "Pairings to time")(
+            "memory,m", po::value<std::size_t>()->default_value(512), "MiB of memory to read at random");
+
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc - 1, argv + 1, desc), vm);
+        po::notify(vm);
+
+        if (vm.count("help")) {
+            std::cout << desc << std::endl;
+            return help_message_exit_code;
+        }
+
+        std::size_t count = vm["points"].as<std::size_t>();
+        std::size_t pairings = vm["pairings"].as<std::size_t>();
+        std::size_t memory = vm["memory"].as<std::size_t>();
+        if (count == 0 || pairings == 0 || memory == 0) {
+            std::cout << "points, pairings and memory must be positive" << std::endl;
+            return usage_error_exit_code;
+        }
+
+        select_kernels(true);
+        bool passed = benchmark_kernels(count);
+        benchmark_pairing(pairings);
+        benchmark_memory(memory);
+        if (!passed) {
+            return invalid_exit_code;
+        }
     } else {
         std::cout << "invalid command: " << command << std::endl;
         std::cout << description << std::endl;
@@ -381,4 +1006,21 @@ int main(int argc, char *argv[]) {
     }
 
     return 0;
+}
+
+int main(int argc, char *argv[]) {
+    // Subcommands report the failures they expect themselves; the rest, bad options or files which can't be read
+    // or hold invalid points, end up here rather than in std::terminate.
+    try {
+        return run_command(argc, argv);
+    } catch (const po::error &e) {
+        std::cout << e.what() << std::endl;
+        return usage_error_exit_code;
+    } catch (const cli::bad_point &e) {
+        std::cout << "Power " << e.index << " of " << describe(e.where) << " is invalid: " << e.what() << std::endl;
+        return invalid_exit_code;
+    } catch (const std::exception &e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        return invalid_exit_code;
+    }
 }
\ No newline at end of file
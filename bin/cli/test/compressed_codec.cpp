@@ -0,0 +1,211 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE cli_compressed_codec_test
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/algebra/curves/bls12.hpp>
+#include <nil/crypto3/algebra/fields/bls12/scalar_field.hpp>
+#include <nil/crypto3/algebra/fields/bls12/base_field.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/bls12.hpp>
+#include <nil/crypto3/algebra/random_element.hpp>
+
+#include <nil/crypto3/marshalling/algebra/types/curve_element.hpp>
+
+#include <nil/crypto3/cli/arithmetic/compressed.hpp>
+#include <nil/crypto3/cli/arithmetic/fp381.hpp>
+#include <nil/crypto3/cli/arithmetic/point_codec.hpp>
+
+using namespace nil::crypto3;
+using namespace nil::crypto3::cli::arithmetic;
+
+using curve_type = algebra::curves::bls12<381>;
+using g1_type = curve_type::g1_type<>;
+using g2_type = curve_type::g2_type<>;
+
+namespace {
+    using integer = std::array<std::uint64_t, 6>;
+
+    constexpr std::uint8_t compression_flag = 0x80;
+    constexpr std::uint8_t infinity_flag = 0x40;
+    constexpr std::uint8_t sign_flag = 0x20;
+
+    constexpr std::array<byte_order, 2> byte_orders = {byte_order::big_endian, byte_order::little_endian};
+
+    template<typename GroupType, typename Endianness>
+    std::vector<std::uint8_t> marshal(const typename GroupType::value_type &point) {
+        auto filled = nil::crypto3::marshalling::types::fill_curve_element<GroupType, Endianness>(point);
+        std::vector<std::uint8_t> blob(filled.length());
+        auto it = blob.begin();
+        BOOST_REQUIRE(filled.write(it, blob.size()) == nil::marshalling::status_type::success);
+        return blob;
+    }
+
+    /// Random points, the identity and the generator among them, encode to what the marshalling writes in the
+    /// same byte order, and what it writes decodes back to them.
+    template<typename GroupType, typename Endianness>
+    void check_against_marshalling(byte_order order) {
+        using value_type = typename GroupType::value_type;
+        using codec_type = point_codec<value_type>;
+
+        std::vector<value_type> points = {value_type::zero(), value_type::one(), -value_type::one()};
+        for (std::size_t i = 0; i < 61; ++i) {
+            points.push_back(algebra::random_element<GroupType>());
+        }
+
+        std::vector<std::uint8_t> expected;
+        for (const value_type &point : points) {
+            std::vector<std::uint8_t> blob = marshal<GroupType, Endianness>(point);
+            BOOST_REQUIRE_EQUAL(blob.size(), codec_type::size);
+            expected.insert(expected.end(), blob.begin(), blob.end());
+        }
+
+        std::vector<std::uint8_t> encoded(expected.size());
+        codec_type::encode(points.data(), points.size(), encoded.data(), order);
+        BOOST_CHECK(encoded == expected);
+
+        std::vector<value_type> decoded(points.size());
+        BOOST_REQUIRE(codec_type::decode(expected.data(), points.size(), decoded.data(), order));
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            BOOST_CHECK_MESSAGE(decoded[i] == points[i], "point " << i << " doesn't round-trip");
+        }
+    }
+
+    /// Writes x as 48 big-endian bytes.
+    void store_coordinate(const integer &x, std::uint8_t *out) {
+        for (std::size_t i = 0; i < 48; ++i) {
+            out[i] = static_cast<std::uint8_t>(x[5 - i / 8] >> (56 - 8 * (i % 8)));
+        }
+    }
+
+    std::array<std::uint8_t, g1_compressed_size> g1_record(const integer &x, std::uint8_t flags) {
+        std::array<std::uint8_t, g1_compressed_size> record;
+        store_coordinate(x, record.data());
+        record[0] |= flags;
+        return record;
+    }
+
+    /// x = x0 + x1 u, x1 first as the integer x1 2^384 + x0 is.
+    std::array<std::uint8_t, g2_compressed_size> g2_record(const integer &x0, const integer &x1, std::uint8_t flags) {
+        std::array<std::uint8_t, g2_compressed_size> record;
+        store_coordinate(x1, record.data());
+        store_coordinate(x0, record.data() + 48);
+        record[0] |= flags;
+        return record;
+    }
+
+    /// Whether a big-endian record decodes, in order; little-endian records are big-endian ones reversed.
+    template<typename Affine, std::size_t Size>
+    bool decodes(std::array<std::uint8_t, Size> record, byte_order order) {
+        if (order == byte_order::little_endian) {
+            std::reverse(record.begin(), record.end());
+        }
+        Affine point;
+        return decode_compressed(record.data(), 1, &point, order);
+    }
+
+    /// Euler's criterion for a nonzero a, independently of the square roots decompression takes.
+    bool is_square(const fp381 &a) {
+        integer exponent = fp381_params::modulus;
+        for (std::size_t i = 0; i < 5; ++i) {
+            exponent[i] = (exponent[i] >> 1) | (exponent[i + 1] << 63);
+        }
+        exponent[5] >>= 1;
+
+        fp381 r = fp381_portable::one();
+        for (std::size_t i = 6; i-- > 0;) {
+            for (std::size_t bit = 64; bit-- > 0;) {
+                r = fp381_portable::sqr(r);
+                if ((exponent[i] >> bit) & 1) {
+                    r = fp381_portable::mul(r, a);
+                }
+            }
+        }
+        return r.limbs == fp381_portable::one().limbs;
+    }
+
+    /// k^3 + 4, the right-hand side of G1 at x = k.
+    fp381 g1_rhs(std::uint64_t k) {
+        fp381 x = to_montgomery({k, 0, 0, 0, 0, 0});
+        return fp381_portable::add(fp381_portable::mul(fp381_portable::sqr(x), x), to_montgomery({4, 0, 0, 0, 0, 0}));
+    }
+
+    /// The norm of (k^3 + 4) + 4 u, the right-hand side of the twist at x = k, which is a square in Fp2 if and
+    /// only if its norm is one in Fp.
+    fp381 g2_rhs_norm(std::uint64_t k) {
+        fp381 c0 = g1_rhs(k);
+        return fp381_portable::add(fp381_portable::sqr(c0), to_montgomery({16, 0, 0, 0, 0, 0}));
+    }
+
+    /// The least k for which rhs(k) is a square, or isn't.
+    template<typename Rhs>
+    std::uint64_t first_x(Rhs rhs, bool square) {
+        std::uint64_t k = 0;
+        while (is_square(rhs(k)) != square) {
+            ++k;
+        }
+        return k;
+    }
+
+    /// 2^381 - 1, the largest x the flags leave room for.
+    constexpr integer all_ones = {~0ull, ~0ull, ~0ull, ~0ull, ~0ull, ~0ull >> 3};
+}    // namespace
+
+BOOST_AUTO_TEST_SUITE(compressed_codec_test_suite)
+
+BOOST_AUTO_TEST_CASE(g1_against_marshalling) {
+    check_against_marshalling<g1_type, nil::marshalling::option::big_endian>(byte_order::big_endian);
+    check_against_marshalling<g1_type, nil::marshalling::option::little_endian>(byte_order::little_endian);
+}
+
+BOOST_AUTO_TEST_CASE(g2_against_marshalling) {
+    check_against_marshalling<g2_type, nil::marshalling::option::big_endian>(byte_order::big_endian);
+    check_against_marshalling<g2_type, nil::marshalling::option::little_endian>(byte_order::little_endian);
+}
+
+BOOST_AUTO_TEST_CASE(g1_malformed) {
+    const integer on_curve = {first_x(g1_rhs, true), 0, 0, 0, 0, 0};
+    const integer off_curve = {first_x(g1_rhs, false), 0, 0, 0, 0, 0};
+    for (byte_order order : byte_orders) {
+        // What the malformed records below are altered from.
+        BOOST_CHECK(decodes<g1_affine>(g1_record(on_curve, compression_flag), order));
+        BOOST_CHECK(decodes<g1_affine>(g1_record({}, compression_flag | infinity_flag), order));
+
+        BOOST_CHECK(!decodes<g1_affine>(g1_record(fp381_params::modulus, compression_flag), order));
+        BOOST_CHECK(!decodes<g1_affine>(g1_record(all_ones, compression_flag), order));
+        BOOST_CHECK(!decodes<g1_affine>(g1_record(on_curve, 0), order));
+        BOOST_CHECK(!decodes<g1_affine>(g1_record({1}, compression_flag | infinity_flag), order));
+        BOOST_CHECK(!decodes<g1_affine>(g1_record({}, compression_flag | infinity_flag | sign_flag), order));
+        BOOST_CHECK(!decodes<g1_affine>(g1_record(off_curve, compression_flag), order));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(g2_malformed) {
+    const integer on_curve = {first_x(g2_rhs_norm, true), 0, 0, 0, 0, 0};
+    const integer off_curve = {first_x(g2_rhs_norm, false), 0, 0, 0, 0, 0};
+    for (byte_order order : byte_orders) {
+        BOOST_CHECK(decodes<g2_affine>(g2_record(on_curve, {}, compression_flag), order));
+        BOOST_CHECK(decodes<g2_affine>(g2_record({}, {}, compression_flag | infinity_flag), order));
+
+        BOOST_CHECK(!decodes<g2_affine>(g2_record(fp381_params::modulus, {}, compression_flag), order));
+        BOOST_CHECK(!decodes<g2_affine>(g2_record(on_curve, fp381_params::modulus, compression_flag), order));
+        BOOST_CHECK(!decodes<g2_affine>(g2_record(on_curve, all_ones, compression_flag), order));
+        BOOST_CHECK(!decodes<g2_affine>(g2_record(on_curve, {}, 0), order));
+        BOOST_CHECK(!decodes<g2_affine>(g2_record({1}, {}, compression_flag | infinity_flag), order));
+        BOOST_CHECK(!decodes<g2_affine>(g2_record({}, {1}, compression_flag | infinity_flag), order));
+        BOOST_CHECK(!decodes<g2_affine>(g2_record({}, {}, compression_flag | infinity_flag | sign_flag), order));
+        BOOST_CHECK(!decodes<g2_affine>(g2_record(off_curve, {}, compression_flag), order));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
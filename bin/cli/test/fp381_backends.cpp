@@ -0,0 +1,154 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE cli_fp381_backends_test
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/cli/arithmetic/fp381.hpp>
+#include <nil/crypto3/cli/arithmetic/kernels.hpp>
+
+using namespace nil::crypto3::cli::arithmetic;
+
+namespace {
+    /// p - k for k <= p, as limbs.
+    fp381 modulus_minus(std::uint64_t k) {
+        fp381 r {fp381_params::modulus};
+        std::uint64_t borrow = k;
+        for (std::size_t i = 0; i < r.limbs.size() && borrow != 0; ++i) {
+            std::uint64_t limb = r.limbs[i];
+            r.limbs[i] = limb - borrow;
+            borrow = limb < borrow ? 1 : 0;
+        }
+        return r;
+    }
+
+    fp381 random_element(std::mt19937_64 &random) {
+        fp381 r;
+        for (std::uint64_t &limb : r.limbs) {
+            limb = random();
+        }
+        // Below the top limb of p, so below p.
+        r.limbs[5] %= fp381_params::modulus[5];
+        return r;
+    }
+
+    /**
+     * Operand pairs: every pair of 0..3 and p-4..p-1, where carries and reductions are at their edges, then
+     * random elements paired with those and with each other. The count is no multiple of any lane width, so
+     * the padded last group is exercised too.
+     */
+    void make_operands(std::vector<fp381> &a, std::vector<fp381> &b) {
+        std::vector<fp381> boundary;
+        for (std::uint64_t k = 0; k < 4; ++k) {
+            boundary.push_back({{k, 0, 0, 0, 0, 0}});
+            boundary.push_back(modulus_minus(4 - k));
+        }
+
+        std::mt19937_64 random(381);
+        for (const fp381 &x : boundary) {
+            for (const fp381 &y : boundary) {
+                a.push_back(x);
+                b.push_back(y);
+            }
+            for (std::size_t i = 0; i < 16; ++i) {
+                fp381 y = random_element(random);
+                a.push_back(x);
+                b.push_back(y);
+                a.push_back(y);
+                b.push_back(x);
+            }
+        }
+        for (std::size_t i = 0; i < 4099; ++i) {
+            a.push_back(random_element(random));
+            b.push_back(random_element(random));
+        }
+    }
+
+    bool same(const std::vector<fp381> &x, const std::vector<fp381> &y) {
+        return x.size() == y.size() && std::memcmp(x.data(), y.data(), x.size() * sizeof(fp381)) == 0;
+    }
+
+    /// Runs a binary operation of table and of the portable backend, also with the result in place of either
+    /// operand, and checks every result agrees.
+    template<typename Entry>
+    void check_binary(const kernel_table &table, Entry entry, const char *name) {
+        std::vector<fp381> a, b;
+        make_operands(a, b);
+        const std::size_t n = a.size();
+
+        std::vector<fp381> expected(n), r(n);
+        (portable_kernels.*entry)(expected.data(), a.data(), b.data(), n);
+
+        (table.*entry)(r.data(), a.data(), b.data(), n);
+        BOOST_CHECK_MESSAGE(same(r, expected), table.name << " " << name << " differs from portable");
+
+        r = a;
+        (table.*entry)(r.data(), r.data(), b.data(), n);
+        BOOST_CHECK_MESSAGE(same(r, expected), table.name << " " << name << " into its first operand differs");
+
+        r = b;
+        (table.*entry)(r.data(), a.data(), r.data(), n);
+        BOOST_CHECK_MESSAGE(same(r, expected), table.name << " " << name << " into its second operand differs");
+
+        (portable_kernels.*entry)(expected.data(), a.data(), a.data(), n);
+        r = a;
+        (table.*entry)(r.data(), r.data(), r.data(), n);
+        BOOST_CHECK_MESSAGE(same(r, expected), table.name << " " << name << " of an operand with itself differs");
+    }
+
+    void check_sqr(const kernel_table &table) {
+        std::vector<fp381> a, b;
+        make_operands(a, b);
+        const std::size_t n = a.size();
+
+        std::vector<fp381> expected(n), r(n);
+        portable_kernels.fp_mul(expected.data(), a.data(), a.data(), n);
+
+        table.fp_sqr(r.data(), a.data(), n);
+        BOOST_CHECK_MESSAGE(same(r, expected), table.name << " sqr differs from portable mul");
+
+        r = a;
+        table.fp_sqr(r.data(), r.data(), n);
+        BOOST_CHECK_MESSAGE(same(r, expected), table.name << " sqr into its operand differs");
+    }
+
+    void check_backend(const kernel_table &table) {
+        check_binary(table, &kernel_table::fp_add, "add");
+        check_binary(table, &kernel_table::fp_sub, "sub");
+        check_binary(table, &kernel_table::fp_mul, "mul");
+        check_sqr(table);
+    }
+}    // namespace
+
+BOOST_AUTO_TEST_SUITE(fp381_backends_test_suite)
+
+// The portable backend is the reference; its squaring is checked against its own multiplication.
+BOOST_AUTO_TEST_CASE(portable) {
+    check_sqr(portable_kernels);
+}
+
+BOOST_AUTO_TEST_CASE(every_backend_against_portable) {
+    for (const kernel_dispatch::candidate &c : dispatch().candidates) {
+        if (c.table == &portable_kernels) {
+            continue;
+        }
+        if (c.result == kernel_dispatch::status::unsupported) {
+            BOOST_TEST_MESSAGE(c.table->name << " skipped, the CPU lacks its instructions");
+            continue;
+        }
+        BOOST_TEST_MESSAGE("checking " << c.table->name);
+        check_backend(*c.table);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,96 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE cli_locate_test
+
+#include <cstddef>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/algebra/curves/bls12.hpp>
+#include <nil/crypto3/algebra/fields/bls12/scalar_field.hpp>
+#include <nil/crypto3/algebra/fields/bls12/base_field.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/bls12.hpp>
+#include <nil/crypto3/algebra/pairing/bls12.hpp>
+
+#include <nil/crypto3/zk/commitments/polynomial/powers_of_tau.hpp>
+
+#include <nil/crypto3/cli/scheduler.hpp>
+#include <nil/crypto3/cli/transform.hpp>
+#include <nil/crypto3/cli/verify.hpp>
+
+using namespace nil::crypto3;
+
+using curve_type = algebra::curves::bls12<381>;
+using scheme_type = zk::commitments::powers_of_tau<curve_type, 8>;
+using accumulator_type = scheme_type::accumulator_type;
+using public_key_type = scheme_type::public_key_type;
+using g1_value_type = curve_type::g1_type<>::value_type;
+
+namespace {
+    /// A contribution to the initial accumulator, as verify sees it: the whole challenge and the response.
+    struct contribution {
+        // The initial accumulator.
+        accumulator_type challenge;
+        accumulator_type response;
+        scheme_type::private_key_type private_key;
+        public_key_type public_key;
+
+        explicit contribution(cli::scheduler &s) :
+            response(challenge), private_key(scheme_type::generate_private_key()),
+            public_key(scheme_type::proof_eval(private_key, challenge)) {
+            cli::transform<scheme_type>(s, response, private_key);
+        }
+
+        bool verify(cli::scheduler &s, bool fail_fast) const {
+            return cli::verify<scheme_type>(s, public_key, challenge, response, fail_fast);
+        }
+
+        std::vector<cli::inconsistency> locate(cli::scheduler &s) const {
+            return cli::locate<scheme_type>(s, public_key, challenge, response);
+        }
+    };
+
+    void check_found(const cli::inconsistency &found, cli::section where, std::size_t first, std::size_t last) {
+        BOOST_CHECK(found.where == where);
+        BOOST_CHECK_EQUAL(found.first, first);
+        BOOST_CHECK_EQUAL(found.last, last);
+    }
+}    // namespace
+
+BOOST_AUTO_TEST_SUITE(locate_test_suite)
+
+BOOST_AUTO_TEST_CASE(valid_contribution) {
+    cli::scheduler s(2);
+    contribution c(s);
+    BOOST_CHECK(c.verify(s, false));
+    BOOST_CHECK(c.verify(s, true));
+    BOOST_CHECK(c.locate(s).empty());
+}
+
+// A power k out of place breaks the pairs on either side of it, so it shows up as the powers k - 1 to k + 1. Neither
+// corrupted power is one the claims on single points read.
+BOOST_AUTO_TEST_CASE(corrupted_powers) {
+    const std::size_t tau_index = 9;
+    const std::size_t beta_tau_index = 5;
+
+    cli::scheduler s(2);
+    contribution c(s);
+    c.response.tau_powers_g1[tau_index] = c.response.tau_powers_g1[tau_index] + g1_value_type::one();
+    c.response.beta_tau_powers_g1[beta_tau_index] =
+        c.response.beta_tau_powers_g1[beta_tau_index] + g1_value_type::one();
+
+    BOOST_CHECK(!c.verify(s, false));
+    BOOST_CHECK(!c.verify(s, true));
+
+    std::vector<cli::inconsistency> found = c.locate(s);
+    BOOST_REQUIRE_EQUAL(found.size(), 2u);
+    check_found(found[0], cli::section::tau_g1, tau_index - 1, tau_index + 1);
+    check_found(found[1], cli::section::beta_tau_g1, beta_tau_index - 1, beta_tau_index + 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
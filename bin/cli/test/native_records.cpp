@@ -0,0 +1,183 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE cli_native_records_test
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/cli/arithmetic/fp381.hpp>
+#include <nil/crypto3/cli/arithmetic/native.hpp>
+
+using namespace nil::crypto3::cli::arithmetic;
+
+namespace {
+    using integer = std::array<std::uint64_t, 6>;
+
+    constexpr std::size_t points_count = 37;
+
+    integer random_integer(std::mt19937_64 &random) {
+        integer a;
+        for (std::uint64_t &limb : a) {
+            limb = random();
+        }
+        // Below the top limb of p, so below p.
+        a[5] %= fp381_params::modulus[5];
+        return a;
+    }
+
+    /// Points with random coordinates, which records don't check to be on the curve, every fifth at infinity.
+    std::vector<g1_affine> random_g1(std::mt19937_64 &random) {
+        std::vector<g1_affine> points(points_count);
+        for (std::size_t i = 0; i < points_count; ++i) {
+            points[i] = {to_montgomery(random_integer(random)), to_montgomery(random_integer(random)), i % 5 == 0};
+        }
+        return points;
+    }
+
+    std::vector<g2_affine> random_g2(std::mt19937_64 &random) {
+        std::vector<g2_affine> points(points_count);
+        for (std::size_t i = 0; i < points_count; ++i) {
+            points[i] = {{to_montgomery(random_integer(random)), to_montgomery(random_integer(random))},
+                         {to_montgomery(random_integer(random)), to_montgomery(random_integer(random))},
+                         i % 5 == 0};
+        }
+        return points;
+    }
+
+    bool same(const fp381 &a, const fp381 &b) {
+        return a.limbs == b.limbs;
+    }
+
+    bool same(const g1_affine &p, const g1_affine &q) {
+        return p.infinity == q.infinity && (p.infinity || (same(p.x, q.x) && same(p.y, q.y)));
+    }
+
+    bool same(const g2_affine &p, const g2_affine &q) {
+        return p.infinity == q.infinity &&
+               (p.infinity || (same(p.x.c0, q.x.c0) && same(p.x.c1, q.x.c1) && same(p.y.c0, q.y.c0) &&
+                               same(p.y.c1, q.y.c1)));
+    }
+
+    /// Stores points and loads them back both ways; this build writes the reference layout or its own, and
+    /// reads either.
+    template<typename Affine>
+    void check_round_trip(const std::vector<Affine> &points, std::size_t record_size) {
+        std::vector<std::uint8_t> records(points.size() * record_size);
+        store_native(points.data(), points.size(), records.data());
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            if (points[i].infinity) {
+                std::vector<std::uint8_t> zeros(record_size);
+                BOOST_CHECK(std::memcmp(records.data() + i * record_size, zeros.data(), record_size) == 0);
+            }
+        }
+
+        for (bool same_build : {true, false}) {
+            std::vector<Affine> loaded(points.size());
+            BOOST_REQUIRE(load_native(records.data(), points.size(), loaded.data(), same_build));
+            for (std::size_t i = 0; i < points.size(); ++i) {
+                BOOST_CHECK_MESSAGE(same(loaded[i], points[i]),
+                                    "point " << i << " differs, same_build " << same_build);
+            }
+        }
+    }
+
+    /// The reference layout of a coordinate of value a: a 2^384 mod p as 48 little-endian bytes.
+    void put_reference(const integer &a, std::uint8_t *out) {
+        integer montgomery = fp381_portable::mul({a}, {fp381_params::r2}).limbs;
+        for (std::size_t i = 0; i < 48; ++i) {
+            out[i] = static_cast<std::uint8_t>(montgomery[i / 8] >> (8 * (i % 8)));
+        }
+    }
+
+    /// p as 48 little-endian bytes, the least coordinate which isn't reduced.
+    void put_modulus(std::uint8_t *out) {
+        for (std::size_t i = 0; i < 48; ++i) {
+            out[i] = static_cast<std::uint8_t>(fp381_params::modulus[i / 8] >> (8 * (i % 8)));
+        }
+    }
+}    // namespace
+
+BOOST_AUTO_TEST_SUITE(native_records_test_suite)
+
+BOOST_AUTO_TEST_CASE(round_trip) {
+    std::mt19937_64 random(96);
+    check_round_trip(random_g1(random), g1_native_size);
+    check_round_trip(random_g2(random), g2_native_size);
+}
+
+// Records written by another build in the reference layout load to the same values here.
+BOOST_AUTO_TEST_CASE(reference_layout) {
+    std::mt19937_64 random(192);
+    std::vector<integer> values(4 * points_count);
+    for (integer &value : values) {
+        value = random_integer(random);
+    }
+
+    std::vector<std::uint8_t> g1_records(points_count * g1_native_size);
+    std::vector<std::uint8_t> g2_records(points_count * g2_native_size);
+    for (std::size_t i = 0; i < points_count; ++i) {
+        for (std::size_t j = 0; j < 2; ++j) {
+            put_reference(values[2 * i + j], g1_records.data() + i * g1_native_size + 48 * j);
+        }
+        for (std::size_t j = 0; j < 4; ++j) {
+            put_reference(values[4 * i + j], g2_records.data() + i * g2_native_size + 48 * j);
+        }
+    }
+
+    std::vector<g1_affine> g1(points_count);
+    std::vector<g2_affine> g2(points_count);
+    BOOST_REQUIRE(load_native(g1_records.data(), points_count, g1.data(), false));
+    BOOST_REQUIRE(load_native(g2_records.data(), points_count, g2.data(), false));
+    for (std::size_t i = 0; i < points_count; ++i) {
+        BOOST_CHECK(!g1[i].infinity && !g2[i].infinity);
+        BOOST_CHECK(from_montgomery(g1[i].x) == values[2 * i]);
+        BOOST_CHECK(from_montgomery(g1[i].y) == values[2 * i + 1]);
+        BOOST_CHECK(from_montgomery(g2[i].x.c0) == values[4 * i]);
+        BOOST_CHECK(from_montgomery(g2[i].x.c1) == values[4 * i + 1]);
+        BOOST_CHECK(from_montgomery(g2[i].y.c0) == values[4 * i + 2]);
+        BOOST_CHECK(from_montgomery(g2[i].y.c1) == values[4 * i + 3]);
+    }
+}
+
+// A coordinate of p or more is refused in any position, however the records are read.
+BOOST_AUTO_TEST_CASE(non_reduced_limbs) {
+    std::mt19937_64 random(288);
+    std::vector<g1_affine> g1 = random_g1(random);
+    std::vector<g2_affine> g2 = random_g2(random);
+    std::vector<std::uint8_t> g1_records(points_count * g1_native_size);
+    std::vector<std::uint8_t> g2_records(points_count * g2_native_size);
+    store_native(g1.data(), points_count, g1_records.data());
+    store_native(g2.data(), points_count, g2_records.data());
+
+    const std::size_t point = points_count - 1;
+    for (bool same_build : {true, false}) {
+        for (std::size_t j = 0; j < 2; ++j) {
+            std::vector<std::uint8_t> records = g1_records;
+            put_modulus(records.data() + point * g1_native_size + 48 * j);
+            BOOST_CHECK(!load_native(records.data(), points_count, g1.data(), same_build));
+        }
+        for (std::size_t j = 0; j < 4; ++j) {
+            std::vector<std::uint8_t> records = g2_records;
+            put_modulus(records.data() + point * g2_native_size + 48 * j);
+            BOOST_CHECK(!load_native(records.data(), points_count, g2.data(), same_build));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(foreign_fingerprint) {
+    BOOST_CHECK(native_readable(native_fingerprint()));
+    BOOST_CHECK(!native_readable(native_fingerprint() ^ 1));
+    BOOST_CHECK(!native_readable(0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
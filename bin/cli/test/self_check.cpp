@@ -0,0 +1,85 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE cli_self_check_test
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/algebra/curves/bls12.hpp>
+#include <nil/crypto3/algebra/fields/bls12/scalar_field.hpp>
+#include <nil/crypto3/algebra/fields/bls12/base_field.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/bls12.hpp>
+#include <nil/crypto3/algebra/pairing/bls12.hpp>
+
+#include <nil/crypto3/zk/commitments/polynomial/powers_of_tau.hpp>
+
+#include <nil/crypto3/cli/scheduler.hpp>
+#include <nil/crypto3/cli/transform.hpp>
+#include <nil/crypto3/cli/verify.hpp>
+
+using namespace nil::crypto3;
+
+using curve_type = algebra::curves::bls12<381>;
+using scheme_type = zk::commitments::powers_of_tau<curve_type, 8>;
+using accumulator_type = scheme_type::accumulator_type;
+using public_key_type = scheme_type::public_key_type;
+using g1_value_type = curve_type::g1_type<>::value_type;
+using g2_value_type = curve_type::g2_type<>::value_type;
+
+namespace {
+    /// What contribute --self-check does up to writing the response: cut the prefix, then transform in place.
+    struct contribution {
+        // The initial accumulator, the challenge of the first contribution.
+        accumulator_type response;
+        accumulator_type challenge_prefix;
+        scheme_type::private_key_type private_key;
+        public_key_type public_key;
+
+        explicit contribution(cli::scheduler &s) :
+            challenge_prefix(cli::powers_prefix(response, 2)), private_key(scheme_type::generate_private_key()),
+            public_key(scheme_type::proof_eval(private_key, response)) {
+            cli::transform<scheme_type>(s, response, private_key);
+        }
+
+        bool check(cli::scheduler &s) const {
+            return cli::verify_against_prefix<scheme_type>(s, public_key, challenge_prefix, response);
+        }
+    };
+}    // namespace
+
+BOOST_AUTO_TEST_SUITE(self_check_test_suite)
+
+BOOST_AUTO_TEST_CASE(valid_transform) {
+    cli::scheduler s(2);
+    contribution c(s);
+    BOOST_CHECK(c.check(s));
+
+    // verify wants the whole challenge; a prefix doesn't have the response's size.
+    BOOST_CHECK(!cli::verify<scheme_type>(s, c.public_key, c.challenge_prefix, c.response));
+}
+
+BOOST_AUTO_TEST_CASE(corrupted_transform) {
+    cli::scheduler s(2);
+    contribution c(s);
+    c.response.tau_powers_g1[5] = c.response.tau_powers_g1[5] + g1_value_type::one();
+    BOOST_CHECK(!c.check(s));
+}
+
+BOOST_AUTO_TEST_CASE(corrupted_beta_g2) {
+    cli::scheduler s(2);
+    contribution c(s);
+    c.response.beta_g2 = c.response.beta_g2 + g2_value_type::one();
+    BOOST_CHECK(!c.check(s));
+}
+
+BOOST_AUTO_TEST_CASE(truncated_response) {
+    cli::scheduler s(2);
+    contribution c(s);
+    c.response.tau_powers_g1.pop_back();
+    BOOST_CHECK(!c.check(s));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,96 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE cli_subgroup_checks_test
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/cli/arithmetic/compressed.hpp>
+#include <nil/crypto3/cli/arithmetic/fp381.hpp>
+#include <nil/crypto3/cli/arithmetic/kernels.hpp>
+
+using namespace nil::crypto3::cli::arithmetic;
+
+namespace {
+    // Enough points for the lanes of every backend and a padded last group.
+    constexpr std::size_t points_count = 11;
+
+    const fp381 one = to_montgomery({1, 0, 0, 0, 0, 0});
+
+    /**
+     * The point with the least x = k, for k = 1, 2, ..., whose x^3 + 4 is a square, as decompression lifts it: y is
+     * the square root and no cofactor is cleared. The cofactor is about 2^126, so the point is on the curve but
+     * outside the prime-order subgroup.
+     */
+    g1_raw lift_g1() {
+        for (std::uint8_t k = 1;; ++k) {
+            std::array<std::uint8_t, g1_compressed_size> record {};
+            record[0] = 0x80;
+            record[g1_compressed_size - 1] = k;
+            g1_affine p;
+            if (decode_compressed(record.data(), 1, &p, byte_order::big_endian)) {
+                return {p.x, p.y, one};
+            }
+        }
+    }
+
+    /// The same on the twist, for x = k + 0 u.
+    g2_raw lift_g2() {
+        for (std::uint8_t k = 1;; ++k) {
+            std::array<std::uint8_t, g2_compressed_size> record {};
+            record[0] = 0x80;
+            record[g2_compressed_size - 1] = k;
+            g2_affine q;
+            if (decode_compressed(record.data(), 1, &q, byte_order::big_endian)) {
+                return {q.x, q.y, {one, {}}};
+            }
+        }
+    }
+
+    /// Puts the lifted point at every index of a run of generators in turn; validate must stop at it, while
+    /// on_curve, which leaves the subgroup aside, must accept the whole run.
+    template<typename Raw, typename Validate, typename OnCurve>
+    void check_group(const char *name, const char *group, const Raw &generator, const Raw &lifted,
+                     Validate validate, OnCurve on_curve) {
+        std::vector<Raw> points(points_count, generator);
+        BOOST_CHECK_MESSAGE(validate(points.data(), points.size()) == points.size(),
+                            name << " rejects the " << group << " generator");
+
+        for (std::size_t index = 0; index < points_count; ++index) {
+            points.assign(points_count, generator);
+            points[index] = lifted;
+            BOOST_CHECK_MESSAGE(validate(points.data(), points.size()) == index,
+                                name << " " << group << " validate misses the point at " << index);
+            BOOST_CHECK_MESSAGE(on_curve(points.data(), points.size()) == points.size(),
+                                name << " " << group << " on_curve rejects the point at " << index);
+        }
+    }
+
+    void check_backend(const kernel_table &table) {
+        check_group(table.name, "G1", g1_generator(), lift_g1(), table.g1_validate, table.g1_on_curve);
+        check_group(table.name, "G2", g2_generator(), lift_g2(), table.g2_validate, table.g2_on_curve);
+    }
+}    // namespace
+
+BOOST_AUTO_TEST_SUITE(subgroup_checks_test_suite)
+
+BOOST_AUTO_TEST_CASE(points_outside_the_subgroup) {
+    for (const kernel_dispatch::candidate &c : dispatch().candidates) {
+        if (c.result == kernel_dispatch::status::unsupported) {
+            BOOST_TEST_MESSAGE(c.table->name << " skipped, the CPU lacks its instructions");
+            continue;
+        }
+        BOOST_TEST_MESSAGE("checking " << c.table->name);
+        check_backend(*c.table);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
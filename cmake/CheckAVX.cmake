@@ -25,6 +25,18 @@ set(AVX2_CODE "
   }
 ")
 
+set(AVX512IFMA_CODE "
+  #include <immintrin.h>
+
+  int main()
+  {
+    __m512i a = _mm512_setzero_si512();
+    a = _mm512_madd52lo_epu64(a, a, a);
+    __mmask8 m = _mm256_cmpeq_epi32_mask(_mm256_setzero_si256(), _mm256_setzero_si256());
+    return (int)m + (int)_mm512_reduce_add_epi64(a);
+  }
+")
+
 macro(check_avx_lang lang type flags)
     set(__FLAG_I 1)
     set(CMAKE_REQUIRED_FLAGS_SAVE ${CMAKE_REQUIRED_FLAGS})
@@ -57,7 +69,9 @@ endmacro()
 macro(check_avx)
     check_avx_lang(C "AVX" " ;-mavx;/arch:AVX")
     check_avx_lang(C "AVX2" " ;-mavx2 -mfma;/arch:AVX2")
+    check_avx_lang(C "AVX512IFMA" " ;-mavx512f -mavx512vl -mavx512ifma")
 
     check_avx_lang(CXX "AVX" " ;-mavx;/arch:AVX")
     check_avx_lang(CXX "AVX2" " ;-mavx2 -mfma;/arch:AVX2")
+    check_avx_lang(CXX "AVX512IFMA" " ;-mavx512f -mavx512vl -mavx512ifma")
 endmacro()
\ No newline at end of file